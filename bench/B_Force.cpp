@@ -0,0 +1,310 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <list>
+#include <string>
+
+#include "BenchUtils.h"
+#include "container/Domain.h"
+#include "container/ParticleContainer.h"
+#include "force/CentralForce.h"
+#include "force/LennardJonesMixture.h"
+#include "force/LennardJonesMolecule.h"
+#include "force/LennardJonesShifted.h"
+#include "force/LennardJonesSmooth.h"
+#include "force/Planet.h"
+#include "force/TabulatedForce.h"
+#include "simulation/StoermerVerlet.h"
+
+namespace {
+
+/**
+ * Lennard-Jones with the cutoff of the assignments, the pairs are found with
+ * linked cells or, if skin > 0, Verlet lists
+ */
+void lennardJones(benchmark::State& state, double skin) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::lattice(n, 1.1225);
+    ParticleContainer container(n, init, 2.5, skin);
+    LennardJonesMolecule method(5, 1);
+    ForceFunction calculate = selectForceFunction(method);
+
+    for (auto _ : state) {
+        calculate(container, method);
+        benchmark::DoNotOptimize(container.force(0));
+    }
+    bench::reportMups(state, n);
+}
+
+void BM_LennardJonesLinkedCells(benchmark::State& state) {
+    lennardJones(state, 0);
+}
+BENCHMARK(BM_LennardJonesLinkedCells)->Apply(bench::particleCounts);
+
+void BM_LennardJonesVerlet(benchmark::State& state) {
+    lennardJones(state, 0.3);
+}
+BENCHMARK(BM_LennardJonesVerlet)->Apply(bench::particleCounts);
+
+/**
+ * Lennard-Jones in a periodic box around the lattice, which adds the ghosts
+ * of the particles on the faces
+ */
+void BM_LennardJonesPeriodic(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    const double h = 1.1225;
+    std::list<Particle> init = bench::lattice(n, h);
+    const double side = std::ceil(std::cbrt((double)n)) * h;
+    Domain domain;
+    domain.size = {side, side, side};
+    domain.boundaries.fill(Boundary::periodic);
+    ParticleContainer container(n, init, 2.5, 0, domain);
+    LennardJonesMolecule method(5, 1);
+    ForceFunction calculate = selectForceFunction(method);
+
+    for (auto _ : state) {
+        calculate(container, method);
+        benchmark::DoNotOptimize(container.force(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_LennardJonesPeriodic)->Apply(bench::particleCounts);
+
+/**
+ * A Lennard-Jones variant ending at the given cutoff with linked cells
+ */
+template <typename ForceT>
+void lennardJonesVariant(benchmark::State& state, const ForceT& method,
+                         double cutoff) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::lattice(n, 1.1225);
+    ParticleContainer container(n, init, cutoff, 0);
+    ForceFunction calculate = selectForceFunction(method);
+
+    for (auto _ : state) {
+        calculate(container, method);
+        benchmark::DoNotOptimize(container.force(0));
+    }
+    bench::reportMups(state, n);
+}
+
+void BM_LennardJonesShifted(benchmark::State& state) {
+    lennardJonesVariant(state, LennardJonesShifted(5, 1, 2.5), 2.5);
+}
+BENCHMARK(BM_LennardJonesShifted)->Apply(bench::particleCounts);
+
+/**
+ * The smooth variant with the smaller cutoff it allows, which halves the
+ * neighbours compared to 2.5
+ */
+void BM_LennardJonesSmooth(benchmark::State& state) {
+    lennardJonesVariant(state, LennardJonesSmooth(5, 1, 1.6, 2), 2);
+}
+BENCHMARK(BM_LennardJonesSmooth)->Apply(bench::particleCounts);
+
+/**
+ * Lennard-Jones with the generic loop, which the tabulated forces use as well
+ */
+void BM_LennardJonesGeneric(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::lattice(n, 1.1225);
+    ParticleContainer container(n, init, 2.5, 0);
+    LennardJonesMolecule method(5, 1);
+    ForceFunction calculate = selectForceFunction(method, SimdLevel::scalar);
+
+    for (auto _ : state) {
+        calculate(container, method);
+        benchmark::DoNotOptimize(container.force(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_LennardJonesGeneric)->Apply(bench::particleCounts);
+
+void BM_TabulatedLinear(benchmark::State& state) {
+    lennardJonesVariant(state,
+                        TabulatedForce(LennardJonesMolecule(5, 1), 0.8, 2.5,
+                                       4096, Interpolation::linear),
+                        2.5);
+}
+BENCHMARK(BM_TabulatedLinear)->Apply(bench::particleCounts);
+
+void BM_TabulatedCubic(benchmark::State& state) {
+    lennardJonesVariant(state,
+                        TabulatedForce(LennardJonesMolecule(5, 1), 0.8, 2.5,
+                                       4096, Interpolation::cubic),
+                        2.5);
+}
+BENCHMARK(BM_TabulatedCubic)->Apply(bench::particleCounts);
+
+/**
+ * The screened Coulomb (Yukawa) force exp(-kappa r) (1 + kappa r) / r^2
+ * between unit charges, an example of a force with transcendental functions
+ */
+class Yukawa final : public CentralForce {
+   public:
+    double calculateScalar(double distanceSq, double /*m1*/,
+                           double /*m2*/) const override {
+        const double r = std::sqrt(distanceSq);
+        return std::exp(-kappa * r) * (1 + kappa * r) / (distanceSq * r);
+    }
+
+    std::string typeString() override { return "Yukawa"; }
+
+   private:
+    double kappa = 1.5;
+};
+
+// unknown to selectForceFunction, so the templated loop is called directly
+void BM_Yukawa(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::lattice(n, 1.1225);
+    ParticleContainer container(n, init, 2.5, 0);
+    Yukawa method;
+
+    for (auto _ : state) {
+        calculateF(container, method);
+        benchmark::DoNotOptimize(container.force(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_Yukawa)->Apply(bench::particleCounts);
+
+void BM_YukawaTabulated(benchmark::State& state) {
+    lennardJonesVariant(state, TabulatedForce(Yukawa(), 0.8, 2.5, 4096), 2.5);
+}
+BENCHMARK(BM_YukawaTabulated)->Apply(bench::particleCounts);
+
+/**
+ * Lennard-Jones between two alternating types, the parameters of every pair
+ * are looked up in the mixing tables
+ */
+void BM_LennardJonesMixture(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init;
+    for (const Particle& p : bench::lattice(n, 1.1225)) {
+        init.emplace_back(p.getX(), p.getV(), p.getM(), (int)init.size() % 2);
+    }
+    ParticleContainer container(n, init, 2.5, 0);
+    LennardJonesMixture method({5, 2}, {1, 1.1});
+    ForceFunction calculate = selectForceFunction(method);
+
+    for (auto _ : state) {
+        calculate(container, method);
+        benchmark::DoNotOptimize(container.force(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_LennardJonesMixture)->Apply(bench::particleCounts);
+
+/**
+ * Lennard-Jones on the lattice in a random order, optionally sorted along the
+ * Morton curve before, which shows the effect of the memory layout
+ */
+void lennardJonesShuffled(benchmark::State& state, bool reorder) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::shuffled(bench::lattice(n, 1.1225));
+    ParticleContainer container(n, init, 2.5, 0);
+    if (reorder) {
+        container.reorder();
+    }
+    LennardJonesMolecule method(5, 1);
+    ForceFunction calculate = selectForceFunction(method);
+
+    for (auto _ : state) {
+        calculate(container, method);
+        benchmark::DoNotOptimize(container.force(0));
+    }
+    bench::reportMups(state, n);
+}
+
+void BM_LennardJonesShuffled(benchmark::State& state) {
+    lennardJonesShuffled(state, false);
+}
+BENCHMARK(BM_LennardJonesShuffled)->Apply(bench::particleCounts);
+
+void BM_LennardJonesReordered(benchmark::State& state) {
+    lennardJonesShuffled(state, true);
+}
+BENCHMARK(BM_LennardJonesReordered)->Apply(bench::particleCounts);
+
+/**
+ * The cost of sorting the particles along the Morton curve, which is paid
+ * once per reorder interval
+ */
+void BM_Reorder(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::shuffled(bench::lattice(n, 1.1225));
+    ParticleContainer container(n, init, 2.5, 0.3);
+    LennardJonesMolecule method(5, 1);
+    calculateF(container, method);
+
+    for (auto _ : state) {
+        container.reorder();
+        benchmark::DoNotOptimize(container.position(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_Reorder)->Apply(bench::particleCounts);
+
+/**
+ * Gravity between all pairs or, if theta > 0, approximated with Barnes-Hut
+ */
+void planet(benchmark::State& state, double theta) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::planets(n);
+    ParticleContainer container(n, init);
+    Planet method(theta);
+    ForceFunction calculate = selectForceFunction(method);
+
+    for (auto _ : state) {
+        calculate(container, method);
+        benchmark::DoNotOptimize(container.force(0));
+    }
+    bench::reportMups(state, n);
+}
+
+// all pairs of 1e5 planets take several seconds per iteration
+void BM_Planet(benchmark::State& state) { planet(state, 0); }
+BENCHMARK(BM_Planet)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->UseRealTime();
+
+void BM_PlanetBarnesHut(benchmark::State& state) { planet(state, 0.5); }
+BENCHMARK(BM_PlanetBarnesHut)->Apply(bench::particleCounts);
+
+/**
+ * Gravity between all pairs with a cutoff larger than the system, directly
+ * or from a table, which replaces the root and the division
+ */
+void planetCutoff(benchmark::State& state, const Force& method) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::planets(n);
+    ParticleContainer container(n, init, 400, 0);
+    ForceFunction calculate = selectForceFunction(method);
+
+    for (auto _ : state) {
+        calculate(container, method);
+        benchmark::DoNotOptimize(container.force(0));
+    }
+    bench::reportMups(state, n);
+}
+
+void BM_PlanetCutoff(benchmark::State& state) {
+    planetCutoff(state, Planet());
+}
+BENCHMARK(BM_PlanetCutoff)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->UseRealTime();
+
+void BM_PlanetTabulated(benchmark::State& state) {
+    planetCutoff(state, TabulatedForce(Planet(), 0.5, 400, 4096,
+                                       Interpolation::cubic, true));
+}
+BENCHMARK(BM_PlanetTabulated)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <string>
+
+#include "BenchUtils.h"
+#include "container/ParticleContainer.h"
+#include "input/CuboidGenerator.h"
+#include "input/FileReader.h"
+
+namespace {
+
+void BM_CuboidGenerator(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    // a cuboid with n particles, 10 particles thick
+    CuboidGenerator cuboid(10, 10, (int)(n / 100), 1.1225, 1, 0.1, {0, 0, 0},
+                           {0, 0, 0});
+
+    for (auto _ : state) {
+        std::list<Particle> particles;
+        cuboid.readData(particles);
+        benchmark::DoNotOptimize(particles.size());
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_CuboidGenerator)->Apply(bench::particleCounts);
+
+void BM_CuboidGeneratorInto(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    CuboidGenerator cuboid(10, 10, (int)(n / 100), 1.1225, 1, 0.1, {0, 0, 0},
+                           {0, 0, 0});
+
+    for (auto _ : state) {
+        ParticleContainer container(cuboid.count());
+        cuboid.readInto(container, 0);
+        benchmark::DoNotOptimize(container.position(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_CuboidGeneratorInto)->Apply(bench::particleCounts);
+
+/**
+ * Writes n planets in the input file format of input/eingabe-sonne.txt
+ */
+std::string writeInputFile(std::size_t n) {
+    const std::string filename =
+        (std::filesystem::temp_directory_path() / "MolSim_bench_input.txt")
+            .string();
+    std::ofstream file(filename);
+    file << "# generated by MolSim_bench\n" << n << "\n";
+    for (const Particle& p : bench::planets(n)) {
+        file << p.getX()[0] << " " << p.getX()[1] << " " << p.getX()[2] << " "
+             << p.getV()[0] << " " << p.getV()[1] << " " << p.getV()[2] << " "
+             << p.getM() << "\n";
+    }
+    return filename;
+}
+
+void BM_FileReader(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    const std::string filename = writeInputFile(n);
+
+    FileReader reader(filename.c_str());
+    for (auto _ : state) {
+        std::list<Particle> particles;
+        reader.readData(particles);
+        benchmark::DoNotOptimize(particles.size());
+    }
+    bench::reportMups(state, n);
+
+    std::remove(filename.c_str());
+}
+BENCHMARK(BM_FileReader)->Apply(bench::particleCounts);
+
+void BM_FileReaderInto(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    const std::string filename = writeInputFile(n);
+
+    FileReader reader(filename.c_str());
+    for (auto _ : state) {
+        ParticleContainer container(reader.count());
+        reader.readInto(container, 0);
+        benchmark::DoNotOptimize(container.position(0));
+    }
+    bench::reportMups(state, n);
+
+    std::remove(filename.c_str());
+}
+BENCHMARK(BM_FileReaderInto)->Apply(bench::particleCounts);
+
+}  // namespace
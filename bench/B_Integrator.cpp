@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "BenchUtils.h"
+#include "container/ParticleContainer.h"
+#include "force/LennardJonesMolecule.h"
+#include "force/Planet.h"
+#include "input/CuboidGenerator.h"
+#include "outputWriter/Writer.h"
+#include "simulation/Simulation.h"
+#include "simulation/StoermerVerlet.h"
+
+namespace {
+
+constexpr double DT = 5e-4;
+
+void BM_calculateX(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::planets(n);
+    ParticleContainer container(n, init);
+
+    for (auto _ : state) {
+        calculateX(container, DT, DT * DT);
+        benchmark::DoNotOptimize(container.position(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_calculateX)->Apply(bench::particleCounts);
+
+void BM_calculateV(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::planets(n);
+    ParticleContainer container(n, init);
+
+    for (auto _ : state) {
+        calculateV(container, DT);
+        benchmark::DoNotOptimize(container.velocity(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_calculateV)->Apply(bench::particleCounts);
+
+/**
+ * The passes over the particles of one step besides the pair loop: the
+ * position update, the reset of the forces and the velocity update
+ */
+void BM_StepSeparate(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::planets(n);
+    ParticleContainer container(n, init);
+
+    for (auto _ : state) {
+        calculateX(container, DT, DT * DT);
+        container.nextIteration();
+        calculateV(container, DT);
+        benchmark::DoNotOptimize(container.velocity(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_StepSeparate)->Apply(bench::particleCounts)->Arg(1000000);
+
+/**
+ * The same step fused into one sweep, the reset in nextIteration is skipped
+ */
+void BM_StepFused(benchmark::State& state) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::planets(n);
+    ParticleContainer container(n, init);
+
+    for (auto _ : state) {
+        calculateKickDrift(container, DT, DT);
+        container.nextIteration();
+        benchmark::DoNotOptimize(container.velocity(0));
+    }
+    bench::reportMups(state, n);
+}
+BENCHMARK(BM_StepFused)->Apply(bench::particleCounts)->Arg(1000000);
+
+/**
+ * Discards the output of the simulation
+ */
+class DiscardingWriter : public Writer {
+   public:
+    void plotParticles(ParticleContainer&, const std::string&, int) override {}
+
+    std::string typeString() override { return "Discarding"; }
+};
+
+/**
+ * Two colliding clusters of warm molecules with Lennard-Jones every
+ * iteration and gravity, approximated with Barnes-Hut, every n iterations.
+ * One benchmark iteration is 20 iterations of the simulation.
+ */
+void BM_RespaGravity(benchmark::State& state) {
+    const int interval = (int)state.range(0);
+    CuboidGenerator first(10, 10, 5, 1.1225, 1, 2, {0, 0, 0}, {0, 0, 0}, 5);
+    CuboidGenerator second(10, 10, 5, 1.1225, 1, 2, {0, 0, 15}, {0, 0, 0}, 5,
+                           1);
+    ParticleContainer container(first.count() + second.count(), 2.5);
+    first.readInto(container, 0);
+    second.readInto(container, first.count());
+
+    Simulation sim(std::move(container),
+                   std::make_shared<LennardJonesMolecule>(5, 1),
+                   std::make_shared<DiscardingWriter>(), DT, 1000, "respa");
+    sim.addForce(std::make_shared<Planet>(0.5), interval);
+
+    for (auto _ : state) {
+        sim.run(0, 19 * DT);
+    }
+    state.SetItemsProcessed(state.iterations() * 20);
+}
+BENCHMARK(BM_RespaGravity)->Arg(1)->Arg(5)->Arg(10)->UseRealTime();
+
+}  // namespace
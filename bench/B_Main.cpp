@@ -0,0 +1,17 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+
+int main(int argc, char* argv[]) {
+    // the simulation expects the loggers of MolSim, their output is discarded
+    spdlog::null_logger_mt("console");
+    spdlog::null_logger_mt("file");
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "BenchUtils.h"
+#include "container/ParticleContainer.h"
+#include "outputWriter/AsyncWriter.h"
+#include "outputWriter/VTKBinaryWriter.h"
+#include "outputWriter/VTKWriter.h"
+#include "outputWriter/XYZWriter.h"
+
+namespace {
+
+/**
+ * Writes all particles with the writer once per iteration, every iteration
+ * overwrites the same file
+ */
+void write(benchmark::State& state, Writer& writer) {
+    const auto n = (std::size_t)state.range(0);
+    std::list<Particle> init = bench::planets(n);
+    ParticleContainer container(n, init);
+
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "MolSim_bench";
+    std::filesystem::create_directories(dir);
+    const std::string prefix = (dir / "out").string();
+
+    for (auto _ : state) {
+        writer.plotParticles(container, prefix, 0);
+    }
+    writer.flush();
+    bench::reportMups(state, n);
+
+    std::filesystem::remove_all(dir);
+}
+
+void BM_XYZWriter(benchmark::State& state) {
+    outputWriter::XYZWriter writer;
+    write(state, writer);
+}
+BENCHMARK(BM_XYZWriter)->Apply(bench::particleCounts);
+
+void BM_VTKWriter(benchmark::State& state) {
+    outputWriter::VTKWriter writer;
+    write(state, writer);
+}
+BENCHMARK(BM_VTKWriter)->Apply(bench::particleCounts);
+
+void BM_VTKBinaryWriter(benchmark::State& state) {
+    outputWriter::VTKBinaryWriter writer;
+    write(state, writer);
+}
+BENCHMARK(BM_VTKBinaryWriter)->Apply(bench::particleCounts);
+
+void BM_VTKBinaryWriterBase64(benchmark::State& state) {
+    outputWriter::VTKBinaryWriter writer(
+        outputWriter::VTKBinaryWriter::Encoding::base64);
+    write(state, writer);
+}
+BENCHMARK(BM_VTKBinaryWriterBase64)->Apply(bench::particleCounts);
+
+void BM_VTKBinaryWriterCompressed(benchmark::State& state) {
+    if (!outputWriter::VTKBinaryWriter::compressionAvailable()) {
+        state.SkipWithError("built without zlib");
+        return;
+    }
+    outputWriter::VTKBinaryWriter writer(
+        outputWriter::VTKBinaryWriter::Encoding::raw, true);
+    write(state, writer);
+}
+BENCHMARK(BM_VTKBinaryWriterCompressed)->Apply(bench::particleCounts);
+
+// measures the time the simulation waits, i.e. the copy into the snapshot
+// buffers and the back-pressure if the disk can not keep up
+void BM_AsyncWriter(benchmark::State& state) {
+    outputWriter::AsyncWriter writer(
+        std::make_shared<outputWriter::VTKBinaryWriter>());
+    write(state, writer);
+}
+BENCHMARK(BM_AsyncWriter)->Apply(bench::particleCounts);
+
+}  // namespace
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "container/Particle.h"
+
+namespace bench {
+
+/**
+ * \brief
+ *  The particle counts every scaling benchmark is run with.
+ *  The wall time is measured, as the CPU time of the main thread does not
+ *  include the other OpenMP threads or the AsyncWriter.
+ */
+inline void particleCounts(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(10)->Range(100, 100000)->UseRealTime();
+}
+
+/**
+ * \brief
+ *  Reports the throughput of a benchmark in million particle updates per
+ *  second (MUPS)
+ * \param n
+ *  The amount of particles updated in every iteration
+ */
+inline void reportMups(benchmark::State& state, std::size_t n) {
+    state.counters["MUPS"] = benchmark::Counter(
+        (double)state.iterations() * n * 1e-6, benchmark::Counter::kIsRate);
+}
+
+/**
+ * \brief
+ *  Creates n particles at rest on a cubic lattice with the given spacing
+ */
+inline std::list<Particle> lattice(std::size_t n, double h) {
+    const auto side = (std::size_t)std::ceil(std::cbrt((double)n));
+    std::list<Particle> particles;
+    for (std::size_t i = 0; i < n; i++) {
+        std::array<double, 3> x = {h * (i % side), h * (i / side % side),
+                                   h * (i / side / side)};
+        particles.emplace_back(x, std::array<double, 3>{0, 0, 0}, 1.);
+    }
+    return particles;
+}
+
+/**
+ * \brief
+ *  Returns the particles in a random order, like after a long run where the
+ *  particles moved away from their neighbours in memory.
+ *  The seed is fixed, so every run benchmarks the same order.
+ */
+inline std::list<Particle> shuffled(const std::list<Particle>& particles) {
+    std::vector<Particle> order(particles.begin(), particles.end());
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(42));
+    return {order.begin(), order.end()};
+}
+
+/**
+ * \brief
+ *  Creates n planets with random positions, velocities and masses.
+ *  The seed is fixed, so every run benchmarks the same system.
+ */
+inline std::list<Particle> planets(std::size_t n) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> pos(-100., 100.);
+    std::uniform_real_distribution<double> vel(-1., 1.);
+    std::uniform_real_distribution<double> mass(1e-3, 1.);
+
+    std::list<Particle> particles;
+    for (std::size_t i = 0; i < n; i++) {
+        std::array<double, 3> x = {pos(rng), pos(rng), pos(rng)};
+        std::array<double, 3> v = {vel(rng), vel(rng), vel(rng)};
+        particles.emplace_back(x, v, mass(rng));
+    }
+    return particles;
+}
+
+}  // namespace bench
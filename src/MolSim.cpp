@@ -4,15 +4,28 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <chrono>
 #include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "container/Domain.h"
 #include "container/ParticleContainer.h"
+#include "force/LennardJonesMixture.h"
+#include "input/CheckpointReader.h"
 #include "input/CuboidGenerator.h"
 #include "input/FileReader.h"
+#include "outputWriter/AsyncWriter.h"
+#include "outputWriter/CheckpointWriter.h"
 #include "simulation/Simulation.h"
 #include "utils/ArrayUtils.h"
 #include "utils/Parser.h"
+#include "utils/Simd.h"
+#include "utils/Threads.h"
 
 int main(int argc, char* argv[]) {
     auto console_logger = spdlog::stderr_color_mt("console");
@@ -46,6 +59,11 @@ int main(int argc, char* argv[]) {
     } else {
         std::stringstream opt_string;
 
+        std::vector<std::string> boundaries;
+        for (Boundary type : opts.domain.boundaries) {
+            boundaries.push_back(boundary::toString(type));
+        }
+
         // prevents unwanted formatting
         // clang-format off
         opt_string << "Parsed options were:\n"
@@ -54,6 +72,17 @@ int main(int argc, char* argv[]) {
                    << "    start: " << opts.start << "\n"
                    << "    end: " << opts.end << "\n"
                    << "    writeout frequency: " << opts.writeoutFrequency << "\n"
+                   << "    timing frequency: " << opts.timingFrequency << "\n"
+                   << "    checkpoint frequency: " << opts.checkpointFrequency << "\n"
+                   << "    restart: " << opts.restart << "\n"
+                   << "    cutoff: " << opts.cutoff << "\n"
+                   << "    skin: " << opts.skin << "\n"
+                   << "    reorder frequency: " << opts.reorderFrequency << "\n"
+                   << "    domain: " << ArrayUtils::to_string(opts.domain.size) << "\n"
+                   << "    boundaries: " << ArrayUtils::to_string(boundaries) << "\n"
+                   << "    theta: " << opts.theta << "\n"
+                   << "    simd: " << simd::toString(opts.simd) << "\n"
+                   << "    threads: " << threads::count() << "\n"
                    << "    file(s): " << ArrayUtils::to_string(opts.filepath) << "\n"
                    << "    outfile prefix: " << opts.outfile << "\n"
                    << "    writer method: " << opts.writer_->typeString() << "\n"
@@ -70,34 +99,116 @@ int main(int argc, char* argv[]) {
         spdlog::get("file")->info(opt_string.str());
         spdlog::get("file")->info(expected_stream.str());
 
-        std::list<Particle> init = std::list<Particle>();
-
+        std::vector<FileReader> fileReaders;
+        fileReaders.reserve(opts.filepath.size());
         for (const auto& file : opts.filepath) {
-            FileReader fileReader(file.c_str());
-            fileReader.readData(init);
+            fileReaders.emplace_back(file.c_str());
         }
 
+        std::vector<Initializer*> initializers;
+        for (auto& fileReader : fileReaders) {
+            initializers.push_back(&fileReader);
+        }
         for (auto& cuboid : opts.cuboids) {
-            cuboid.readData(init);
+            initializers.push_back(&cuboid);
         }
 
-        std::stringstream particleCount;
-
-        particleCount << "Particle count: " << init.size();
-        spdlog::get("file")->debug(particleCount.str());
-
-        if (init.size() < 2) {
-            spdlog::get("console")->critical(
-                "The simulation requires at least 2 particles! "
-                "Include them via file or cuboid.");
+        // the particles are written directly into the final arrays
+        ParticleContainer container;
+        int firstIteration = 0;
+        try {
+            std::unique_ptr<CheckpointReader> checkpoint;
+            if (!opts.restart.empty()) {
+                checkpoint = std::make_unique<CheckpointReader>(opts.restart);
+                // the stored forces belong to the cutoff of the checkpoint
+                checkpoint->checkParameters(opts.cutoff, opts.skin);
+                initializers.push_back(checkpoint.get());
+
+                // continues with the time step of the checkpoint
+                firstIteration = (int)checkpoint->getIteration() + 1;
+                opts.delta_t = checkpoint->getDt();
+                spdlog::get("file")->info(
+                    "Restarting from {} at t = {} (iteration {}) with delta_t "
+                    "= {}",
+                    opts.restart, checkpoint->getTime(), firstIteration,
+                    opts.delta_t);
+            }
+
+            std::vector<std::size_t> counts;
+            std::size_t count = 0;
+            for (Initializer* initializer : initializers) {
+                counts.push_back(initializer->count());
+                count += counts.back();
+            }
+
+            std::stringstream particleCount;
+
+            particleCount << "Particle count: " << count;
+            spdlog::get("file")->debug(particleCount.str());
+
+            if (count < 2) {
+                spdlog::get("console")->critical(
+                    "The simulation requires at least 2 particles! "
+                    "Include them via file or cuboid.");
+                exit(1);
+            }
+
+            container =
+                ParticleContainer(count, opts.cutoff, opts.skin, opts.domain);
+
+            std::size_t offset = 0;
+            for (std::size_t i = 0; i < initializers.size(); i++) {
+                initializers[i]->readInto(container, offset);
+                offset += counts[i];
+            }
+        } catch (const std::runtime_error& e) {
+            spdlog::get("console")->critical("Error reading input: {}",
+                                             e.what());
             exit(1);
         }
 
-        ParticleContainer container = ParticleContainer(init.size(), init);
+        // the mixture only has parameters for its types
+        if (const auto* mixture =
+                dynamic_cast<const LennardJonesMixture*>(opts.force_.get())) {
+            const int* types = container.type();
+            const int* outside = std::find_if(
+                types, types + container.size(), [&](int type) {
+                    return type < 0 || type >= mixture->getTypes();
+                });
+            if (outside != types + container.size()) {
+                spdlog::get("console")->critical(
+                    "Particle {} has type {}, but Lennard-Jones parameters "
+                    "were only given for {} types",
+                    outside - types, *outside, mixture->getTypes());
+                exit(1);
+            }
+        }
 
-        Simulation sim(container, opts.force_, opts.writer_, opts.delta_t,
-                       opts.writeoutFrequency, opts.outfile);
+        Simulation sim(std::move(container), opts.force_, opts.writer_,
+                       opts.delta_t, opts.writeoutFrequency, opts.outfile,
+                       opts.simd, opts.timingFrequency);
+
+        if (opts.checkpointFrequency > 0) {
+            std::shared_ptr<Writer> checkpointWriter =
+                std::make_shared<outputWriter::CheckpointWriter>(
+                    opts.delta_t, opts.cutoff, opts.skin);
+            if (opts.outputBuffers > 0) {
+                checkpointWriter = std::make_shared<outputWriter::AsyncWriter>(
+                    checkpointWriter, 1);
+            }
+            sim.setCheckpoint(checkpointWriter, opts.checkpointFrequency);
+        }
 
-        sim.run(opts.start, opts.end);
+        sim.setReorderFrequency(opts.reorderFrequency);
+        sim.setFused(opts.fused);
+        if (opts.maxDisplacement > 0) {
+            sim.setAdaptive(opts.maxDisplacement,
+                            opts.minStep > 0 ? opts.minStep
+                                             : opts.delta_t / 1e6);
+        }
+        if (opts.slowForce_) {
+            sim.addForce(opts.slowForce_, opts.slowInterval);
+        }
+        sim.run(opts.start, opts.end, firstIteration);
     }
 }
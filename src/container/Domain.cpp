@@ -0,0 +1,34 @@
+#include "Domain.h"
+
+namespace boundary {
+
+bool parse(const std::string& name, Boundary& type) {
+    if (name == "none") {
+        type = Boundary::none;
+    } else if (name == "periodic") {
+        type = Boundary::periodic;
+    } else if (name == "reflect") {
+        type = Boundary::reflect;
+    } else if (name == "outflow") {
+        type = Boundary::outflow;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string toString(Boundary type) {
+    switch (type) {
+        case Boundary::none:
+            return "none";
+        case Boundary::periodic:
+            return "periodic";
+        case Boundary::reflect:
+            return "reflect";
+        case Boundary::outflow:
+            return "outflow";
+    }
+    return "NOT A BOUNDARY";
+}
+
+}  // namespace boundary
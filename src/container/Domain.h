@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+/**
+ * \brief
+ *  What happens to particles at a face of the domain
+ */
+enum class Boundary {
+    /** Particles may leave the domain and keep interacting */
+    none,
+    /** Particles leaving the domain enter it on the opposite face and
+       interact with the particles there */
+    periodic,
+    /** Particles are mirrored back into the domain and their velocity
+       orthogonal to the face is inverted */
+    reflect,
+    /** Particles leaving the domain are removed from the simulation */
+    outflow
+};
+
+/**
+ * \brief
+ *  The simulated box, spanning from the origin to size.
+ *  The faces are ordered -x, +x, -y, +y, -z, +z.
+ *  A size of 0 leaves the domain unbounded, then all boundaries are ignored.
+ */
+struct Domain {
+    /**
+     * \brief
+     *  The side lengths of the domain
+     */
+    std::array<double, 3> size{};
+
+    /**
+     * \brief
+     *  The boundary of every face
+     */
+    std::array<Boundary, 6> boundaries{};
+
+    /**
+     * \brief
+     *  Checks if the domain has a size in every dimension
+     */
+    [[nodiscard]] bool isBounded() const {
+        return size[0] > 0 && size[1] > 0 && size[2] > 0;
+    }
+
+    /**
+     * \brief
+     *  Checks if dimension d is periodic.
+     *  Periodic boundaries always come in pairs of opposite faces.
+     * \param d
+     *  The dimension (0, 1 or 2)
+     */
+    [[nodiscard]] bool isPeriodic(int d) const {
+        return isBounded() && boundaries[2 * d] == Boundary::periodic;
+    }
+
+    /**
+     * \brief
+     *  Checks if any face reflects or removes particles
+     */
+    [[nodiscard]] bool hasWalls() const {
+        if (!isBounded()) {
+            return false;
+        }
+        for (Boundary type : boundaries) {
+            if (type == Boundary::reflect || type == Boundary::outflow) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+namespace boundary {
+
+/**
+ * \brief
+ *  Parses the name of a boundary
+ * \param name
+ *  One of "none", "periodic", "reflect" or "outflow"
+ * \param type
+ *  The parsed boundary, only written on success
+ * \return
+ *  True if name was valid
+ */
+bool parse(const std::string& name, Boundary& type);
+
+/**
+ * \brief
+ *  Returns the name of the boundary
+ */
+std::string toString(Boundary type);
+
+}  // namespace boundary
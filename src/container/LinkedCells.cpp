@@ -0,0 +1,216 @@
+#include "LinkedCells.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// clang-format off
+const std::array<std::array<int, 3>, 13> LinkedCells::stencil = {{
+    {-1, -1, 1}, {0, -1, 1}, {1, -1, 1},
+    {-1,  0, 1}, {0,  0, 1}, {1,  0, 1},
+    {-1,  1, 1}, {0,  1, 1}, {1,  1, 1},
+    {-1,  1, 0}, {0,  1, 0}, {1,  1, 0},
+    { 1,  0, 0}
+}};
+// clang-format on
+
+LinkedCells::LinkedCells(double cutoff_, const Domain& domain_)
+    : cutoff(cutoff_), domain(domain_) {
+    dims = {1, 1, 1};
+    cellSize = {cutoff, cutoff, cutoff};
+    innerEnd = dims;
+    cellStart = {0, 0};
+    if (domain.isBounded()) {
+        fitDomain();
+    }
+}
+
+std::size_t LinkedCells::cellOf(double x, double y, double z) const {
+    std::array<double, 3> position = {x, y, z};
+    std::array<std::size_t, 3> index{};
+    for (int d = 0; d < 3; d++) {
+        double relative = (position[d] - origin[d]) / cellSize[d];
+        // the upper boundary of the bounding box belongs to the last cell,
+        // particles are never sorted into halo cells
+        index[d] = std::clamp((std::size_t)std::max(relative, 0.),
+                              innerBegin[d], innerEnd[d] - 1);
+    }
+    return (index[2] * dims[1] + index[1]) * dims[0] + index[0];
+}
+
+void LinkedCells::fitBoundingBox(const double* x, const double* y,
+                                 const double* z, std::size_t count) {
+    std::array<const double*, 3> positions = {x, y, z};
+    std::array<double, 3> lower{};
+    std::array<double, 3> upper{};
+
+    for (int d = 0; d < 3; d++) {
+        double low = std::numeric_limits<double>::max();
+        double up = std::numeric_limits<double>::lowest();
+        for (std::size_t i = 0; i < count; i++) {
+            low = std::min(low, positions[d][i]);
+            up = std::max(up, positions[d][i]);
+        }
+        lower[d] = low;
+        upper[d] = up;
+    }
+
+    if (count == 0) {
+        lower = {0, 0, 0};
+        upper = {0, 0, 0};
+    }
+
+    // cells have to be at least cutoff wide, so we round the amount down
+    std::array<double, 3> extent{};
+    double total = 1;
+    for (int d = 0; d < 3; d++) {
+        extent[d] = upper[d] - lower[d];
+        double amount = std::max(1., std::floor(extent[d] / cutoff));
+        dims[d] = (std::size_t)std::min(amount, 1e6);
+        total *= (double)dims[d];
+    }
+
+    // widely scattered particles would result in mostly empty cells, so the
+    // amount of cells is limited relative to the amount of particles
+    double maxCells = std::max(27., 2. * (double)count);
+    while (total > maxCells) {
+        std::size_t largest =
+            std::max_element(dims.begin(), dims.end()) - dims.begin();
+        dims[largest] = std::max<std::size_t>(1, dims[largest] / 2);
+        total = (double)dims[0] * (double)dims[1] * (double)dims[2];
+    }
+
+    origin = lower;
+    for (int d = 0; d < 3; d++) {
+        cellSize[d] = extent[d] > 0 ? extent[d] / (double)dims[d] : cutoff;
+    }
+    innerBegin = {0, 0, 0};
+    innerEnd = dims;
+}
+
+void LinkedCells::fitDomain() {
+    for (int d = 0; d < 3; d++) {
+        double amount = std::max(1., std::floor(domain.size[d] / cutoff));
+        std::size_t inner = (std::size_t)std::min(amount, 1e6);
+        cellSize[d] = domain.size[d] / (double)inner;
+
+        if (domain.isPeriodic(d)) {
+            // one layer of halo cells on both sides
+            dims[d] = inner + 2;
+            origin[d] = -cellSize[d];
+            innerBegin[d] = 1;
+            innerEnd[d] = inner + 1;
+        } else {
+            dims[d] = inner;
+            origin[d] = 0;
+            innerBegin[d] = 0;
+            innerEnd[d] = inner;
+        }
+    }
+}
+
+void LinkedCells::createGhosts(std::size_t count) {
+    ghosts.clear();
+    for (std::size_t i = 0; i < count; i++) {
+        const std::size_t cell = particleCell[i];
+        const std::array<std::size_t, 3> index = {
+            cell % dims[0], (cell / dims[0]) % dims[1],
+            cell / (dims[0] * dims[1])};
+
+        // the periods the particle is shifted by in every dimension
+        std::array<std::array<int, 3>, 3> periods{};
+        std::array<int, 3> periodCount = {1, 1, 1};
+        for (int d = 0; d < 3; d++) {
+            if (!domain.isPeriodic(d)) {
+                continue;
+            }
+            if (index[d] == innerBegin[d]) {
+                periods[d][periodCount[d]++] = 1;
+            }
+            if (index[d] == innerEnd[d] - 1) {
+                periods[d][periodCount[d]++] = -1;
+            }
+        }
+
+        // every combination except the particle itself, up to 7 in a corner
+        for (int a = 0; a < periodCount[0]; a++) {
+            for (int b = 0; b < periodCount[1]; b++) {
+                for (int c = 0; c < periodCount[2]; c++) {
+                    if (a == 0 && b == 0 && c == 0) {
+                        continue;
+                    }
+                    std::array<int, 3> period = {periods[0][a], periods[1][b],
+                                                 periods[2][c]};
+                    Ghost ghost{i, {}};
+                    std::array<std::size_t, 3> ghostIndex{};
+                    for (int d = 0; d < 3; d++) {
+                        ghost.shift[d] = period[d] * domain.size[d];
+                        const long inner = (long)(innerEnd[d] - innerBegin[d]);
+                        ghostIndex[d] =
+                            (std::size_t)((long)index[d] + period[d] * inner);
+                    }
+                    ghosts.push_back(ghost);
+                    particleCell.push_back(
+                        (ghostIndex[2] * dims[1] + ghostIndex[1]) * dims[0] +
+                        ghostIndex[0]);
+                }
+            }
+        }
+    }
+}
+
+void LinkedCells::rebuild(const double* x, const double* y, const double* z,
+                          std::size_t count) {
+    if (!domain.isBounded()) {
+        fitBoundingBox(x, y, z, count);
+    }
+
+    particleCell.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        particleCell[i] = cellOf(x[i], y[i], z[i]);
+    }
+    if (domain.isPeriodic(0) || domain.isPeriodic(1) || domain.isPeriodic(2)) {
+        createGhosts(count);
+    }
+
+    // counting sort of the particle and ghost indices by their cell
+    const std::size_t total = particleCell.size();
+    std::size_t cells = cellCount();
+    cellStart.assign(cells + 1, 0);
+    for (std::size_t i = 0; i < total; i++) {
+        cellStart[particleCell[i] + 1]++;
+    }
+    for (std::size_t c = 0; c < cells; c++) {
+        cellStart[c + 1] += cellStart[c];
+    }
+
+    cellParticles.resize(total);
+    std::vector<std::size_t> next(cellStart.begin(), cellStart.end() - 1);
+    for (std::size_t i = 0; i < total; i++) {
+        cellParticles[next[particleCell[i]]++] = i;
+    }
+}
+
+std::size_t LinkedCells::cellCount() const {
+    return dims[0] * dims[1] * dims[2];
+}
+
+const std::vector<LinkedCells::Ghost>& LinkedCells::getGhosts() const {
+    return ghosts;
+}
+
+void LinkedCells::renumber(std::vector<std::size_t>& newIndex,
+                           std::size_t count, std::size_t newCount) {
+    std::size_t kept = 0;
+    for (std::size_t g = 0; g < ghosts.size(); g++) {
+        const std::size_t origin = newIndex[ghosts[g].origin];
+        if (origin == REMOVED) {
+            newIndex[count + g] = REMOVED;
+            continue;
+        }
+        ghosts[kept] = {origin, ghosts[g].shift};
+        newIndex[count + g] = newCount + kept;
+        kept++;
+    }
+    ghosts.resize(kept);
+}
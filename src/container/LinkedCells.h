@@ -0,0 +1,294 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "Domain.h"
+
+/**
+ * \brief
+ *  Bins particles into a regular grid of cells with a side length of at least
+ *  the cutoff radius.
+ *  Two particles closer than the cutoff are therefore always located in the
+ *  same or in directly neighbouring cells, which allows to find all relevant
+ *  pairs in O(N) instead of O(N^2).
+ *
+ *  Without a bounded domain the grid spans the bounding box of the particles
+ *  and is recalculated on every rebuild, so particles can never leave it.
+ *  With a bounded domain the grid is fixed to the domain. Particles outside
+ *  of it are sorted into the closest cell, which keeps the pairs correct.
+ *
+ *  Periodic dimensions get an additional layer of halo cells on both sides.
+ *  The particles of the outermost cells are copied into the halo cells on
+ *  the opposite side (ghosts), so pairs across the boundary are found like
+ *  any other pair. Only the inner cells are traversed, therefore every pair
+ *  is still visited exactly once.
+ */
+class LinkedCells {
+   public:
+    /**
+     * \brief
+     *  A periodic image of a particle in the halo cells
+     */
+    struct Ghost {
+        /** The index of the particle the ghost is a copy of */
+        std::size_t origin;
+        /** The offset of the ghost to its origin */
+        std::array<double, 3> shift;
+    };
+
+    /**
+     * \brief
+     *  Marks a removed particle when mapping old to new indices
+     */
+    static constexpr std::size_t REMOVED =
+        std::numeric_limits<std::size_t>::max();
+
+   private:
+    /**
+     * \brief
+     *  The minimal side length of a cell (the cutoff radius)
+     */
+    double cutoff;
+
+    /**
+     * \brief
+     *  The lower left front corner of the grid
+     */
+    std::array<double, 3> origin{};
+
+    /**
+     * \brief
+     *  The side length of the cells in every direction
+     */
+    std::array<double, 3> cellSize{};
+
+    /**
+     * \brief
+     *  The amount of cells in every direction
+     */
+    std::array<std::size_t, 3> dims{};
+
+    /**
+     * \brief
+     *  The first and one past the last index of the cells which are
+     *  traversed in every direction. Excludes the halo cells.
+     */
+    std::array<std::size_t, 3> innerBegin{}, innerEnd{};
+
+    /**
+     * \brief
+     *  The domain, fixes the grid if it is bounded
+     */
+    Domain domain;
+
+    /**
+     * \brief
+     *  The ghosts of the last rebuild. The ghost g has the index count + g.
+     */
+    std::vector<Ghost> ghosts;
+
+    /**
+     * \brief
+     *  For every cell the index of its first entry in cellParticles.
+     *  Contains one additional entry, so the particles of cell c are located in
+     *  [cellStart[c], cellStart[c + 1]).
+     */
+    std::vector<std::size_t> cellStart;
+
+    /**
+     * \brief
+     *  The particle indices sorted by their cell
+     */
+    std::vector<std::size_t> cellParticles;
+
+    /**
+     * \brief
+     *  The cell of every particle, only used while rebuilding
+     */
+    std::vector<std::size_t> particleCell;
+
+    /**
+     * \brief
+     *  Half of the neighbouring cells (13 of 26) as offsets.
+     *  Visiting only these avoids calculating the same pair twice.
+     */
+    static const std::array<std::array<int, 3>, 13> stencil;
+
+    /**
+     * \brief
+     *  Calculates the index of the cell containing the given position
+     */
+    [[nodiscard]] std::size_t cellOf(double x, double y, double z) const;
+
+    /**
+     * \brief
+     *  Fits the grid to the bounding box of the particles
+     */
+    void fitBoundingBox(const double* x, const double* y, const double* z,
+                        std::size_t count);
+
+    /**
+     * \brief
+     *  Fixes the grid to the domain, with halo cells in periodic dimensions
+     */
+    void fitDomain();
+
+    /**
+     * \brief
+     *  Creates the ghosts of the particles in the outermost inner cells of
+     *  the periodic dimensions and appends their cells to particleCell.
+     *  The cell of a ghost is derived from the cell of its origin, so it is
+     *  always located in the opposite halo cell.
+     * \param count
+     *  The amount of particles
+     */
+    void createGhosts(std::size_t count);
+
+   public:
+    /**
+     * \brief
+     *  Creates an empty grid
+     * \param cutoff_
+     *  The cutoff radius, has to be greater than 0
+     * \param domain_
+     *  The domain, if bounded the grid is fixed to it. Periodic dimensions
+     *  have to be at least two cutoff radii wide.
+     */
+    explicit LinkedCells(double cutoff_ = 1, const Domain& domain_ = {});
+
+    /**
+     * \brief
+     *  Recalculates the grid dimensions and sorts the particles into the cells.
+     *  In periodic dimensions the particles have to be inside of the domain,
+     *  the ghosts are created anew.
+     * \param x
+     *  The x coordinates of the particles
+     * \param y
+     *  The y coordinates of the particles
+     * \param z
+     *  The z coordinates of the particles
+     * \param count
+     *  The amount of particles
+     */
+    void rebuild(const double* x, const double* y, const double* z,
+                 std::size_t count);
+
+    /**
+     * \brief
+     *  Returns the amount of cells of the grid
+     */
+    [[nodiscard]] std::size_t cellCount() const;
+
+    /**
+     * \brief
+     *  Returns the ghosts of the last rebuild, empty without periodic
+     *  dimensions. The ghost g has the particle index count + g in the
+     *  candidate blocks, its position has to be provided by the caller.
+     */
+    [[nodiscard]] const std::vector<Ghost>& getGhosts() const;
+
+    /**
+     * \brief
+     *  Renumbers the origins of the ghosts after the particles were
+     *  reordered or removed. The ghosts of removed particles are dropped, the
+     *  others keep their order behind the particles.
+     *  The cells themselves are outdated afterwards and have to be rebuilt
+     *  before they are traversed again.
+     * \param newIndex
+     *  For every particle its new index or REMOVED, followed by an entry
+     *  for every ghost, which is filled in with the new index of the ghost.
+     * \param count
+     *  The amount of particles before
+     * \param newCount
+     *  The amount of particles afterwards
+     */
+    void renumber(std::vector<std::size_t>& newIndex, std::size_t count,
+                  std::size_t newCount);
+
+    /**
+     * \brief
+     *  Calls f(i, neighbours, count) for every particle i and every block of
+     *  candidates located in the same or in a neighbouring cell.
+     *  Every unordered pair is contained exactly once.
+     *  All candidates of a particle i are visited consecutively.
+     *  i is never a ghost, the candidates can be ghosts.
+     *  Pairs may be further apart than the cutoff and have to be filtered by
+     *  the caller.
+     *  Inside of a parallel region this has to be called by all threads and
+     *  the cells are distributed among them.
+     * \param f
+     *  The function to call for every block
+     */
+    template <typename F>
+    void forEachCandidateBlock(F&& f) const {
+        const std::size_t cells = dims[0] * dims[1] * dims[2];
+
+#pragma omp for schedule(static, 8)
+        for (std::size_t cell = 0; cell < cells; cell++) {
+            const std::size_t cx = cell % dims[0];
+            const std::size_t cy = (cell / dims[0]) % dims[1];
+            const std::size_t cz = cell / (dims[0] * dims[1]);
+            // the halo cells only contain ghosts, their pairs are found from
+            // the inner cells
+            if (cx < innerBegin[0] || cx >= innerEnd[0] ||
+                cy < innerBegin[1] || cy >= innerEnd[1] ||
+                cz < innerBegin[2] || cz >= innerEnd[2]) {
+                continue;
+            }
+
+            // collect the neighbouring cells inside of the grid
+            std::array<std::size_t, 13> neighbours{};
+            std::size_t neighbourCount = 0;
+            for (const auto& offset : stencil) {
+                long nx = (long)cx + offset[0];
+                long ny = (long)cy + offset[1];
+                long nz = (long)cz + offset[2];
+                if (nx < 0 || ny < 0 || nz < 0 || nx >= (long)dims[0] ||
+                    ny >= (long)dims[1] || nz >= (long)dims[2]) {
+                    continue;
+                }
+                neighbours[neighbourCount++] =
+                    (nz * dims[1] + ny) * dims[0] + nx;
+            }
+
+            for (std::size_t a = cellStart[cell]; a < cellStart[cell + 1];
+                 a++) {
+                std::size_t i = cellParticles[a];
+
+                // pairs inside of the cell
+                f(i, cellParticles.data() + a + 1,
+                  cellStart[cell + 1] - a - 1);
+
+                // pairs with the neighbouring cells
+                for (std::size_t n = 0; n < neighbourCount; n++) {
+                    std::size_t first = cellStart[neighbours[n]];
+                    f(i, cellParticles.data() + first,
+                      cellStart[neighbours[n] + 1] - first);
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief
+     *  Calls f(i, j) for every unordered pair of particle indices located in
+     *  the same or in neighbouring cells. Every pair is visited exactly once.
+     *  All candidates of a particle i are visited consecutively.
+     *  Pairs may be further apart than the cutoff and have to be filtered by
+     *  the caller.
+     * \param f
+     *  The function to call for every pair
+     */
+    template <typename F>
+    void forEachCandidatePair(F&& f) const {
+        forEachCandidateBlock(
+            [&f](std::size_t i, const std::size_t* block, std::size_t count) {
+                for (std::size_t k = 0; k < count; k++) {
+                    f(i, block[k]);
+                }
+            });
+    }
+};
@@ -0,0 +1,201 @@
+#include "Octree.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "utils/Morton.h"
+
+namespace {
+/**
+ * The level whose cells are built in parallel, 8^2 = 64 subtrees
+ */
+constexpr int SPLIT_LEVEL = 2;
+
+/**
+ * The amount of subtrees on SPLIT_LEVEL
+ */
+constexpr std::size_t SUBTREES = std::size_t{1} << (3 * SPLIT_LEVEL);
+
+/**
+ * The shift of a Morton code to get the index of its cell on the given level
+ */
+constexpr int shiftOf(int level) { return 3 * (morton::BITS - level); }
+}  // namespace
+
+Octree::Octree(std::size_t leafSize_) : leafSize(leafSize_) {}
+
+void Octree::sort(const double* x, const double* y, const double* z,
+                  const double* m, std::size_t count) {
+    // the root cell is the bounding cube of all particles
+    double lowX = std::numeric_limits<double>::max();
+    double lowY = lowX;
+    double lowZ = lowX;
+    double upX = std::numeric_limits<double>::lowest();
+    double upY = upX;
+    double upZ = upX;
+
+#pragma omp parallel for schedule(static) \
+    reduction(min : lowX, lowY, lowZ) reduction(max : upX, upY, upZ)
+    for (std::size_t i = 0; i < count; i++) {
+        lowX = std::min(lowX, x[i]);
+        lowY = std::min(lowY, y[i]);
+        lowZ = std::min(lowZ, z[i]);
+        upX = std::max(upX, x[i]);
+        upY = std::max(upY, y[i]);
+        upZ = std::max(upZ, z[i]);
+    }
+
+    rootSize = std::max({upX - lowX, upY - lowY, upZ - lowZ});
+    if (!(rootSize > 0)) {
+        rootSize = 1;
+    }
+    const double inverseSide = 1. / rootSize;
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> unsorted(count);
+#pragma omp parallel for schedule(static)
+    for (std::size_t i = 0; i < count; i++) {
+        unsorted[i] = {morton::encode(morton::quantize(x[i], lowX, inverseSide),
+                                      morton::quantize(y[i], lowY, inverseSide),
+                                      morton::quantize(z[i], lowZ, inverseSide)),
+                       i};
+    }
+
+    // counting sort by the subtree, then every subtree is sorted on its own
+    bucketStart.assign(SUBTREES + 1, 0);
+    for (const auto& entry : unsorted) {
+        bucketStart[(entry.first >> shiftOf(SPLIT_LEVEL)) + 1]++;
+    }
+    for (std::size_t b = 0; b < SUBTREES; b++) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> sorted(count);
+    std::vector<std::size_t> next(bucketStart.begin(), bucketStart.end() - 1);
+    for (const auto& entry : unsorted) {
+        sorted[next[entry.first >> shiftOf(SPLIT_LEVEL)]++] = entry;
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (std::size_t b = 0; b < SUBTREES; b++) {
+        std::sort(sorted.begin() + bucketStart[b],
+                  sorted.begin() + bucketStart[b + 1]);
+    }
+
+    keys.resize(count);
+    order.resize(count);
+    sortedX.resize(count);
+    sortedY.resize(count);
+    sortedZ.resize(count);
+    sortedM.resize(count);
+
+#pragma omp parallel for schedule(static)
+    for (std::size_t k = 0; k < count; k++) {
+        const std::size_t i = sorted[k].second;
+        keys[k] = sorted[k].first;
+        order[k] = i;
+        sortedX[k] = x[i];
+        sortedY[k] = y[i];
+        sortedZ[k] = z[i];
+        sortedM[k] = m[i];
+    }
+}
+
+void Octree::buildNode(int level, std::size_t first, std::size_t last,
+                       std::vector<Node>& out, bool splice) const {
+    if (splice && level == SPLIT_LEVEL) {
+        const std::vector<Node>& subtree =
+            subtrees[keys[first] >> shiftOf(SPLIT_LEVEL)];
+        const std::size_t base = out.size();
+        for (Node node : subtree) {
+            node.next += base;
+            out.push_back(node);
+        }
+        return;
+    }
+
+    const std::size_t index = out.size();
+    out.emplace_back();
+
+    Node node{};
+    node.size = rootSize / (double)(std::uint64_t{1} << level);
+    node.first = first;
+    node.count = last - first;
+
+    double mass = 0;
+    double x = 0;
+    double y = 0;
+    double z = 0;
+
+    if (node.count <= leafSize || level == morton::BITS) {
+        node.leaf = true;
+        for (std::size_t k = first; k < last; k++) {
+            mass += sortedM[k];
+            x += sortedM[k] * sortedX[k];
+            y += sortedM[k] * sortedY[k];
+            z += sortedM[k] * sortedZ[k];
+        }
+    } else {
+        node.leaf = false;
+        // the particles of a child share the next 3 bits of their code
+        const int shift = shiftOf(level + 1);
+        std::size_t begin = first;
+        while (begin < last) {
+            const std::uint64_t cell = keys[begin] >> shift;
+            const std::size_t end =
+                std::partition_point(
+                    keys.begin() + begin, keys.begin() + last,
+                    [&](std::uint64_t key) { return (key >> shift) == cell; }) -
+                keys.begin();
+
+            const std::size_t child = out.size();
+            buildNode(level + 1, begin, end, out, splice);
+            mass += out[child].mass;
+            x += out[child].mass * out[child].x;
+            y += out[child].mass * out[child].y;
+            z += out[child].mass * out[child].z;
+
+            begin = end;
+        }
+    }
+
+    if (mass != 0) {
+        node.x = x / mass;
+        node.y = y / mass;
+        node.z = z / mass;
+    } else {
+        // massless particles do not exert a force, any position works
+        node.x = sortedX[first];
+        node.y = sortedY[first];
+        node.z = sortedZ[first];
+    }
+    node.mass = mass;
+    node.next = out.size();
+    out[index] = node;
+}
+
+void Octree::build(const double* x, const double* y, const double* z,
+                   const double* m, std::size_t count) {
+    sort(x, y, z, m, count);
+
+    nodes.clear();
+    if (count == 0) {
+        return;
+    }
+
+    // the subtrees are independent, afterwards the levels above them are
+    // built and the subtrees are copied into place
+    subtrees.resize(SUBTREES);
+#pragma omp parallel for schedule(dynamic)
+    for (std::size_t b = 0; b < SUBTREES; b++) {
+        subtrees[b].clear();
+        if (bucketStart[b] < bucketStart[b + 1]) {
+            buildNode(SPLIT_LEVEL, bucketStart[b], bucketStart[b + 1],
+                      subtrees[b], false);
+        }
+    }
+
+    buildNode(0, 0, count, nodes, true);
+}
+
+std::size_t Octree::nodeCount() const { return nodes.size(); }
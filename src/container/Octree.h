@@ -0,0 +1,242 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief
+ *  Octree over the particles for the Barnes-Hut approximation of long range
+ *  pair forces like gravity.
+ *
+ *  A group of particles far away from a particle acts like a single particle
+ *  with their total mass located at their center of mass. A cell is far
+ *  enough away if its side length divided by the distance to its center of
+ *  mass is smaller than the opening angle theta. This reduces the force
+ *  calculation from O(N^2) to O(N log N).
+ *
+ *  The particles are sorted along a Morton curve, so every cell of the tree
+ *  contains a contiguous range of particles. The nodes are stored in depth
+ *  first order with the index of the node following their subtree, so the
+ *  tree can be traversed without a stack.
+ */
+class Octree {
+   private:
+    /**
+     * \brief
+     *  A cell of the tree
+     */
+    struct Node {
+        /** The center of mass of all particles in the cell */
+        double x;
+        double y;
+        double z;
+
+        /** The total mass of all particles in the cell */
+        double mass;
+
+        /** The side length of the cell */
+        double size;
+
+        /** The particles of the cell are [first, first + count) in sorted
+         * order */
+        std::size_t first;
+        std::size_t count;
+
+        /** The index of the first node after the subtree of this node */
+        std::size_t next;
+
+        /** Leaves have no children, their particles interact directly */
+        bool leaf;
+    };
+
+    /**
+     * \brief
+     *  The maximal amount of particles in a leaf
+     */
+    std::size_t leafSize;
+
+    /**
+     * \brief
+     *  The nodes in depth first order, the root is the first one
+     */
+    std::vector<Node> nodes;
+
+    /**
+     * \brief
+     *  The subtrees below the level where the build is split among the
+     *  threads, only used while building
+     */
+    std::vector<std::vector<Node>> subtrees;
+
+    /**
+     * \brief
+     *  The first sorted particle of every subtree, with one additional entry
+     *  for the end
+     */
+    std::vector<std::size_t> bucketStart;
+
+    /**
+     * \brief
+     *  The Morton code of every particle in sorted order
+     */
+    std::vector<std::uint64_t> keys;
+
+    /**
+     * \brief
+     *  The index in the container of every particle in sorted order
+     */
+    std::vector<std::size_t> order;
+
+    /**
+     * \brief
+     *  The positions and masses of the particles in sorted order
+     */
+    std::vector<double> sortedX;
+    std::vector<double> sortedY;
+    std::vector<double> sortedZ;
+    std::vector<double> sortedM;
+
+    /**
+     * \brief
+     *  The side length of the root cell
+     */
+    double rootSize = 0;
+
+    /**
+     * \brief
+     *  Sorts the particles by their Morton code
+     */
+    void sort(const double* x, const double* y, const double* z,
+              const double* m, std::size_t count);
+
+    /**
+     * \brief
+     *  Appends the subtree of the cell on the given level containing the
+     *  sorted particles [first, last) to out.
+     *  If splice is set, the prebuilt subtrees are copied on the level they
+     *  were built for.
+     */
+    void buildNode(int level, std::size_t first, std::size_t last,
+                   std::vector<Node>& out, bool splice) const;
+
+   public:
+    /**
+     * \brief
+     *  Creates an empty tree
+     * \param leafSize_
+     *  The maximal amount of particles in a leaf
+     */
+    explicit Octree(std::size_t leafSize_ = 8);
+
+    /**
+     * \brief
+     *  Builds the tree for the given particles, the build is distributed
+     *  among all threads
+     * \param x
+     *  The x coordinates of the particles
+     * \param y
+     *  The y coordinates of the particles
+     * \param z
+     *  The z coordinates of the particles
+     * \param m
+     *  The masses of the particles
+     * \param count
+     *  The amount of particles
+     */
+    void build(const double* x, const double* y, const double* z,
+               const double* m, std::size_t count);
+
+    /**
+     * \brief
+     *  Returns the amount of nodes of the tree
+     */
+    [[nodiscard]] std::size_t nodeCount() const;
+
+    /**
+     * \brief
+     *  Returns the index in the container of the k-th particle in sorted
+     *  order. Visiting the particles in this order keeps the traversed nodes
+     *  in the cache.
+     */
+    [[nodiscard]] std::size_t particleAt(std::size_t k) const {
+        return order[k];
+    }
+
+    /**
+     * \brief
+     *  Calculates the force on the k-th particle in sorted order from all
+     *  other particles. Cells fulfilling the opening criterion are
+     *  approximated by their center of mass.
+     * \tparam ForceT
+     *  The type of the force
+     * \param k
+     *  The index of the particle in sorted order, see particleAt
+     * \param method
+     *  The force, calculateScalar is called with the masses of the particle
+     *  and the cell
+     * \param theta
+     *  The opening angle, 0 calculates all pairs directly
+     * \return
+     *  The force on the particle
+     */
+    template <typename ForceT>
+    std::array<double, 3> calculateForce(std::size_t k, const ForceT& method,
+                                         double theta) const {
+        const double xi = sortedX[k];
+        const double yi = sortedY[k];
+        const double zi = sortedZ[k];
+        const double mi = sortedM[k];
+        const double theta_sq = theta * theta;
+        double fx = 0;
+        double fy = 0;
+        double fz = 0;
+
+        std::size_t n = 0;
+        while (n < nodes.size()) {
+            const Node& node = nodes[n];
+
+            if (node.leaf) {
+                for (std::size_t j = node.first; j < node.first + node.count;
+                     j++) {
+                    if (j == k) {
+                        continue;
+                    }
+                    const double dx = xi - sortedX[j];
+                    const double dy = yi - sortedY[j];
+                    const double dz = zi - sortedZ[j];
+                    const double s = method.calculateScalar(
+                        dx * dx + dy * dy + dz * dz, mi, sortedM[j]);
+                    fx += s * dx;
+                    fy += s * dy;
+                    fz += s * dz;
+                }
+                n = node.next;
+                continue;
+            }
+
+            const double dx = xi - node.x;
+            const double dy = yi - node.y;
+            const double dz = zi - node.z;
+            const double distanceSq = dx * dx + dy * dy + dz * dz;
+
+            // a cell containing the particle itself is always opened
+            const bool contains =
+                k >= node.first && k < node.first + node.count;
+            if (!contains && node.size * node.size < theta_sq * distanceSq) {
+                const double s =
+                    method.calculateScalar(distanceSq, mi, node.mass);
+                fx += s * dx;
+                fy += s * dy;
+                fz += s * dz;
+                n = node.next;
+            } else {
+                // the first child follows directly
+                n++;
+            }
+        }
+
+        return {fx, fy, fz};
+    }
+};
@@ -1,15 +1,472 @@
 #include "ParticleContainer.h"
 
-ParticleContainer::ParticleContainer(std::size_t length_,
-                                     std::list<Particle>& init)
-    : length(length_) {
-    // init new array
-    particleArray = std::vector<Particle>();
-    particleArray.reserve(length);
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "utils/Morton.h"
+
+ParticleContainer::ParticleContainer(std::size_t length_, double cutoff_,
+                                     double skin_, const Domain& domain_)
+    : length(length_),
+      cutoff(cutoff_),
+      domain(domain_),
+      cells(cutoff_ + skin_, domain_),
+      skin(skin_),
+      verlet(skin_) {
+    // init new arrays
+    for (int d = 0; d < 3; d++) {
+        positions[d].resize(length);
+        velocities[d].resize(length);
+        forces[d].resize(length);
+        oldForces[d].resize(length);
+    }
+    masses.resize(length);
+    types.resize(length);
 
+    allIndices.resize(length);
+    std::iota(allIndices.begin(), allIndices.end(), 0);
+}
+
+ParticleContainer::ParticleContainer(std::size_t length_,
+                                     std::list<Particle>& init, double cutoff_,
+                                     double skin_, const Domain& domain_)
+    : ParticleContainer(length_, cutoff_, skin_, domain_) {
+    std::size_t i = 0;
     for (Particle& p : init) {
-        particleArray.push_back(p);
+        if (i == length) {
+            break;
+        }
+        for (int d = 0; d < 3; d++) {
+            positions[d][i] = p.getX()[d];
+            velocities[d][i] = p.getV()[d];
+            forces[d][i] = p.getF()[d];
+            oldForces[d][i] = p.getOldF()[d];
+        }
+        masses[i] = p.getM();
+        types[i] = p.getType();
+        i++;
+    }
+}
+
+std::size_t ParticleContainer::size() const { return length; }
+
+void ParticleContainer::copyParticles(const ParticleContainer& other) {
+    // assign reuses the capacity of the arrays, the ghosts are not copied
+    const std::size_t n = other.length;
+    for (int d = 0; d < 3; d++) {
+        positions[d].assign(other.positions[d].begin(),
+                            other.positions[d].begin() + n);
+        velocities[d].assign(other.velocities[d].begin(),
+                             other.velocities[d].begin() + n);
+        forces[d].assign(other.forces[d].begin(),
+                         other.forces[d].begin() + n);
+        oldForces[d].assign(other.oldForces[d].begin(),
+                            other.oldForces[d].begin() + n);
+    }
+    masses.assign(other.masses.begin(), other.masses.begin() + n);
+    types.assign(other.types.begin(), other.types.begin() + n);
+
+    if (length != other.length) {
+        length = other.length;
+        allIndices.resize(length);
+        std::iota(allIndices.begin(), allIndices.end(), 0);
+    }
+
+    // the lists belong to the old particles
+    verlet.invalidate();
+}
+
+void ParticleContainer::nextIteration() {
+    if (forcesCleared) {
+        forcesCleared = false;
+        return;
+    }
+    // the old forces are overwritten anyway, so swapping avoids a copy
+    for (int d = 0; d < 3; d++) {
+        forces[d].swap(oldForces[d]);
+    }
+    double* fx = forces[0].data();
+    double* fy = forces[1].data();
+    double* fz = forces[2].data();
+
+#pragma omp parallel for simd schedule(static)
+    for (std::size_t i = 0; i < length; i++) {
+        fx[i] = 0.;
+        fy[i] = 0.;
+        fz[i] = 0.;
+    }
+}
+
+void ParticleContainer::swapClearedForces() {
+    for (int d = 0; d < 3; d++) {
+        forces[d].swap(oldForces[d]);
+    }
+    forcesCleared = true;
+}
+
+void ParticleContainer::keepForces() { forcesCleared = true; }
+
+void ParticleContainer::scaleForces(double factor) {
+    double* fx = forces[0].data();
+    double* fy = forces[1].data();
+    double* fz = forces[2].data();
+
+#pragma omp parallel for simd schedule(static)
+    for (std::size_t i = 0; i < length; i++) {
+        fx[i] *= factor;
+        fy[i] *= factor;
+        fz[i] *= factor;
+    }
+}
+
+std::size_t ParticleContainer::removeParticles(
+    const std::vector<char>& remove) {
+    const std::size_t ghosts = ghostCount();
+    newIndex.resize(length + ghosts);
+
+    // stable compaction, every particle is moved at most once
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < length; i++) {
+        if (remove[i]) {
+            newIndex[i] = LinkedCells::REMOVED;
+            continue;
+        }
+        newIndex[i] = kept;
+        if (kept != i) {
+            for (int d = 0; d < 3; d++) {
+                positions[d][kept] = positions[d][i];
+                velocities[d][kept] = velocities[d][i];
+                forces[d][kept] = forces[d][i];
+                oldForces[d][kept] = oldForces[d][i];
+            }
+            masses[kept] = masses[i];
+            types[kept] = types[i];
+        }
+        kept++;
+    }
+
+    const std::size_t removed = length - kept;
+    if (removed == 0) {
+        return 0;
     }
+
+    // the ghosts of the remaining particles move down behind them
+    cells.renumber(newIndex, length, kept);
+    for (std::size_t g = 0; g < ghosts; g++) {
+        const std::size_t to = newIndex[length + g];
+        if (to == LinkedCells::REMOVED) {
+            continue;
+        }
+        for (int d = 0; d < 3; d++) {
+            positions[d][to] = positions[d][length + g];
+        }
+        masses[to] = masses[length + g];
+        types[to] = types[length + g];
+    }
+
+    // the Verlet lists stay valid, the removed pairs are just dropped
+    verlet.renumber(newIndex, kept + ghostCount());
+
+    // shrinking keeps the capacity, so the arrays are not reallocated
+    length = kept;
+    const std::size_t total = length + ghostCount();
+    for (int d = 0; d < 3; d++) {
+        positions[d].resize(total);
+        velocities[d].resize(length);
+        forces[d].resize(total);
+        oldForces[d].resize(total);
+    }
+    masses.resize(total);
+    types.resize(total);
+    allIndices.resize(length);
+    return removed;
 }
 
-std::size_t ParticleContainer::size() const { return length; }
\ No newline at end of file
+void ParticleContainer::reorder() {
+    if (length < 2) {
+        return;
+    }
+
+    std::array<double, 3> lower{};
+    std::array<double, 3> upper{};
+    for (int d = 0; d < 3; d++) {
+        const double* x = positions[d].data();
+        double low = std::numeric_limits<double>::max();
+        double up = std::numeric_limits<double>::lowest();
+#pragma omp parallel for simd schedule(static) reduction(min : low) \
+    reduction(max : up)
+        for (std::size_t i = 0; i < length; i++) {
+            low = std::min(low, x[i]);
+            up = std::max(up, x[i]);
+        }
+        lower[d] = low;
+        upper[d] = up;
+    }
+
+    double width = cutoff + skin;
+    if (cutoff <= 0) {
+        width = std::max({upper[0] - lower[0], upper[1] - lower[1],
+                          upper[2] - lower[2]}) /
+                1024;
+    }
+    // all particles at the same position
+    if (!(width > 0)) {
+        return;
+    }
+    const double inverseWidth = 1 / width;
+
+    sortKeys.resize(length);
+    const double* x = positions[0].data();
+    const double* y = positions[1].data();
+    const double* z = positions[2].data();
+#pragma omp parallel for schedule(static)
+    for (std::size_t i = 0; i < length; i++) {
+        auto cell = [&](double position, int d) {
+            const double c = std::floor((position - lower[d]) * inverseWidth);
+            return (std::uint64_t)std::min(c, (double)(morton::GRID - 1));
+        };
+        sortKeys[i] = {
+            morton::encode(cell(x[i], 0), cell(y[i], 1), cell(z[i], 2)), i};
+    }
+    // the index breaks ties, so the order is deterministic
+    std::sort(sortKeys.begin(), sortKeys.end());
+
+    const std::size_t ghosts = ghostCount();
+    newIndex.resize(length + ghosts);
+    for (std::size_t k = 0; k < length; k++) {
+        newIndex[sortKeys[k].second] = k;
+    }
+    for (std::size_t g = 0; g < ghosts; g++) {
+        newIndex[length + g] = length + g;
+    }
+
+    // gathers the particles of every array, the ghosts stay where they are
+    auto gather = [this](auto& array, auto& buffer) {
+        buffer.resize(array.size());
+#pragma omp parallel for schedule(static)
+        for (std::size_t k = 0; k < length; k++) {
+            buffer[k] = array[sortKeys[k].second];
+        }
+        std::copy(array.begin() + length, array.end(),
+                  buffer.begin() + length);
+        array.swap(buffer);
+    };
+    for (int d = 0; d < 3; d++) {
+        gather(positions[d], scratch);
+        gather(velocities[d], scratch);
+        gather(forces[d], scratch);
+        gather(oldForces[d], scratch);
+    }
+    gather(masses, scratch);
+    AlignedVector<int> typeScratch;
+    gather(types, typeScratch);
+
+    cells.renumber(newIndex, length, length);
+    verlet.renumber(newIndex, length + ghosts);
+}
+
+std::size_t ParticleContainer::applyBoundaries() {
+    if (!domain.hasWalls()) {
+        return 0;
+    }
+
+    std::size_t outside = 0;
+    for (int d = 0; d < 3; d++) {
+        const Boundary lower = domain.boundaries[2 * d];
+        const Boundary upper = domain.boundaries[2 * d + 1];
+        const double size = domain.size[d];
+        double* x = positions[d].data();
+        double* v = velocities[d].data();
+
+        if (lower == Boundary::reflect || upper == Boundary::reflect) {
+            const bool reflectLower = lower == Boundary::reflect;
+            const bool reflectUpper = upper == Boundary::reflect;
+#pragma omp parallel for simd schedule(static)
+            for (std::size_t i = 0; i < length; i++) {
+                // mirrored at the face, only once
+                if (reflectLower && x[i] < 0) {
+                    x[i] = -x[i];
+                    v[i] = -v[i];
+                } else if (reflectUpper && x[i] > size) {
+                    x[i] = 2 * size - x[i];
+                    v[i] = -v[i];
+                }
+            }
+        }
+
+        if (lower == Boundary::outflow || upper == Boundary::outflow) {
+            const double low = lower == Boundary::outflow
+                                   ? 0
+                                   : std::numeric_limits<double>::lowest();
+            const double up = upper == Boundary::outflow
+                                  ? size
+                                  : std::numeric_limits<double>::max();
+#pragma omp parallel for simd schedule(static) reduction(+ : outside)
+            for (std::size_t i = 0; i < length; i++) {
+                outside += (x[i] < low || x[i] > up) ? 1 : 0;
+            }
+        }
+    }
+
+    // usually no particle left, then the removal is skipped entirely
+    if (outside == 0) {
+        return 0;
+    }
+
+    leaving.assign(length, 0);
+    for (int d = 0; d < 3; d++) {
+        const double* x = positions[d].data();
+        const double size = domain.size[d];
+        const bool lower = domain.boundaries[2 * d] == Boundary::outflow;
+        const bool upper = domain.boundaries[2 * d + 1] == Boundary::outflow;
+        for (std::size_t i = 0; i < length; i++) {
+            if ((lower && x[i] < 0) || (upper && x[i] > size)) {
+                leaving[i] = 1;
+            }
+        }
+    }
+    return removeParticles(leaving);
+}
+
+void ParticleContainer::updateNeighbours() {
+    if (cutoff <= 0) {
+        return;
+    }
+    if (skin <= 0 || verlet.needsRebuild()) {
+        wrapPeriodic();
+        cells.rebuild(position(0), position(1), position(2), length);
+        updateGhosts(true);
+        if (skin > 0) {
+            // the lists contain the ghosts as well
+            verlet.build(cells, position(0), position(1), position(2),
+                         length + ghostCount(), cutoff);
+        }
+    } else {
+        updateGhosts(false);
+    }
+}
+
+std::size_t ParticleContainer::ghostCount() const {
+    return cells.getGhosts().size();
+}
+
+void ParticleContainer::wrapPeriodic() {
+    for (int d = 0; d < 3; d++) {
+        if (!domain.isPeriodic(d)) {
+            continue;
+        }
+        const double size = domain.size[d];
+        double* x = positions[d].data();
+#pragma omp parallel for simd schedule(static)
+        for (std::size_t i = 0; i < length; i++) {
+            x[i] -= size * std::floor(x[i] / size);
+        }
+    }
+}
+
+void ParticleContainer::updateGhosts(bool rebuilt) {
+    const auto& ghosts = cells.getGhosts();
+    const std::size_t total = length + ghosts.size();
+    if (rebuilt) {
+        // the ghosts need no velocities
+        for (int d = 0; d < 3; d++) {
+            positions[d].resize(total);
+            forces[d].resize(total);
+            oldForces[d].resize(total);
+        }
+        masses.resize(total);
+        types.resize(total);
+    }
+
+#pragma omp parallel for schedule(static)
+    for (std::size_t g = 0; g < ghosts.size(); g++) {
+        const std::size_t origin = ghosts[g].origin;
+        for (int d = 0; d < 3; d++) {
+            positions[d][length + g] =
+                positions[d][origin] + ghosts[g].shift[d];
+            forces[d][length + g] = 0;
+        }
+        if (rebuilt) {
+            masses[length + g] = masses[origin];
+            types[length + g] = types[origin];
+        }
+    }
+}
+
+void ParticleContainer::foldGhostForces() {
+    const auto& ghosts = cells.getGhosts();
+    // particles have up to 7 ghosts, so this is not parallelized
+    for (std::size_t g = 0; g < ghosts.size(); g++) {
+        for (int d = 0; d < 3; d++) {
+            forces[d][ghosts[g].origin] += forces[d][length + g];
+        }
+    }
+}
+
+const Octree& ParticleContainer::buildOctree() {
+    tree.build(position(0), position(1), position(2), mass(), length);
+    return tree;
+}
+
+void ParticleContainer::prepareThreadForces(int threads) {
+    threadForces.resize(threads - 1);
+    for (auto& buffer : threadForces) {
+        for (int d = 0; d < 3; d++) {
+            buffer[d].resize(length + ghostCount());
+        }
+    }
+}
+
+void ParticleContainer::clearThreadForces(int thread) {
+    if (thread == 0) {
+        return;
+    }
+    for (int d = 0; d < 3; d++) {
+        std::fill(threadForces[thread - 1][d].begin(),
+                  threadForces[thread - 1][d].end(), 0.);
+    }
+}
+
+void ParticleContainer::reduceThreadForces() {
+    if (threadForces.empty()) {
+        return;
+    }
+    const std::size_t total = length + ghostCount();
+    for (int d = 0; d < 3; d++) {
+        double* f = forces[d].data();
+        for (auto& buffer : threadForces) {
+            const double* g = buffer[d].data();
+
+            // every loop gives a thread the same particles, so they do not
+            // have to wait for each other
+#pragma omp for simd schedule(static) nowait
+            for (std::size_t i = 0; i < total; i++) {
+                f[i] += g[i];
+            }
+        }
+    }
+}
+
+double ParticleContainer::getCutoff() const { return cutoff; }
+
+double ParticleContainer::getSkin() const { return skin; }
+
+const Domain& ParticleContainer::getDomain() const { return domain; }
+
+std::size_t ParticleContainer::originOf(std::size_t j) const {
+    return j < length ? j : cells.getGhosts()[j - length].origin;
+}
+
+std::size_t ParticleContainer::getRebuildCount() const {
+    return verlet.getRebuildCount();
+}
+
+const double* ParticleContainer::getReferencePosition(int d) const {
+    return skin > 0 ? verlet.getReference(d) : nullptr;
+}
+
+void ParticleContainer::updateDisplacement(double displacementSq) {
+    verlet.updateDisplacement(displacementSq);
+}
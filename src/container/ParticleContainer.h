@@ -1,25 +1,249 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <list>
+#include <utility>
 #include <vector>
 
+#include "Domain.h"
+#include "LinkedCells.h"
+#include "Octree.h"
 #include "Particle.h"
+#include "ParticleRef.h"
+#include "VerletList.h"
+#include "utils/AlignedAllocator.h"
+#include "utils/Threads.h"
 
 /**
  * \brief
  *  A container for particles
+ *
+ *  The particles are stored as a structure of arrays: every component has its
+ *  own contiguous, cache line aligned array (one per dimension for vectors).
+ *  Loops over a single component therefore only load the data they need and
+ *  can be vectorized by the compiler.
+ *  Iterating over the container yields ParticleRef objects, which offer the
+ *  interface of a single particle.
+ *
+ *  With periodic boundaries the position, force, mass and type arrays are
+ *  followed by the ghosts of the linked cells, so the force kernels can
+ *  treat them like particles. Their forces are added to the particles they
+ *  are copies of after every force calculation.
  */
 class ParticleContainer {
    private:
     /**
-     * The array containing all particles
+     * The positions of all particles, one array per dimension
      */
-    std::vector<Particle> particleArray;
+    std::array<AlignedVector<double>, 3> positions;
+
+    /**
+     * The velocities of all particles, one array per dimension
+     */
+    std::array<AlignedVector<double>, 3> velocities;
+
+    /**
+     * The forces of all particles, one array per dimension
+     */
+    std::array<AlignedVector<double>, 3> forces;
+
+    /**
+     * The forces of the last iteration of all particles, one array per
+     * dimension
+     */
+    std::array<AlignedVector<double>, 3> oldForces;
+
+    /**
+     * The masses of all particles
+     */
+    AlignedVector<double> masses;
+
+    /**
+     * The types of all particles
+     */
+    AlignedVector<int> types;
 
     /**
      * The amount of particles in the container
      */
-    std::size_t length;
+    std::size_t length = 0;
+
+    /**
+     * If the next call of nextIteration keeps the forces, because they were
+     * already reset by swapClearedForces or should be added to by keepForces
+     */
+    bool forcesCleared = false;
+
+    /**
+     * The cutoff radius, particles further apart do not interact.
+     * A cutoff of 0 disables it, then all pairs are calculated.
+     */
+    double cutoff = 0;
+
+    /**
+     * The simulated box and its boundaries, unbounded by default
+     */
+    Domain domain;
+
+    /**
+     * The linked cells used to find the pairs inside of the cutoff radius.
+     * Only used if a cutoff is set.
+     */
+    LinkedCells cells;
+
+    /**
+     * The width of the skin around the cutoff radius used for the Verlet
+     * lists. A skin of 0 disables the Verlet lists.
+     */
+    double skin = 0;
+
+    /**
+     * The Verlet lists, only used if a cutoff and a skin are set.
+     */
+    VerletList verlet;
+
+    /**
+     * The indices 0 to length - 1, used as neighbour list if all pairs are
+     * calculated.
+     */
+    std::vector<std::size_t> allIndices;
+
+    /**
+     * The octree for the Barnes-Hut approximation, only built on request.
+     */
+    Octree tree;
+
+    /**
+     * For every particle if it left the domain through an outflow face, only
+     * used while applying the boundaries
+     */
+    std::vector<char> leaving;
+
+    /**
+     * The new index of every particle and ghost, only used while removing
+     * particles
+     */
+    std::vector<std::size_t> newIndex;
+
+    /**
+     * The Morton code of the cell and the index of every particle, only used
+     * while reordering
+     */
+    std::vector<std::pair<std::uint64_t, std::size_t>> sortKeys;
+
+    /**
+     * The array the particles are gathered into while reordering, swapped
+     * with the reordered arrays so every array reuses the memory of the
+     * previous one
+     */
+    AlignedVector<double> scratch;
+
+    /**
+     * The private force arrays of the threads 1 to n - 1, one array per
+     * dimension. Thread 0 writes into forces directly.
+     */
+    std::vector<std::array<AlignedVector<double>, 3>> threadForces;
+
+    /**
+     * \brief
+     *  Rebuilds the linked cells or the Verlet lists if necessary, so the
+     *  neighbour blocks can be traversed.
+     *  Must not be called by multiple threads at once.
+     */
+    void updateNeighbours();
+
+    /**
+     * \brief
+     *  Returns the amount of ghosts behind the particles
+     */
+    [[nodiscard]] std::size_t ghostCount() const;
+
+    /**
+     * \brief
+     *  Moves the particles which left the domain in a periodic dimension to
+     *  the opposite side. Only done before the linked cells are rebuilt, as
+     *  the Verlet lists would become invalid otherwise.
+     */
+    void wrapPeriodic();
+
+    /**
+     * \brief
+     *  Moves the ghosts to the current positions of their origins and resets
+     *  their forces
+     * \param rebuilt
+     *  True if the ghosts were just created, then the arrays are resized and
+     *  the masses and types are copied as well
+     */
+    void updateGhosts(bool rebuilt);
+
+    /**
+     * \brief
+     *  Adds the forces of the ghosts to the particles they are copies of
+     */
+    void foldGhostForces();
+
+    /**
+     * \brief
+     *  Calls f(i, neighbours, count) for every neighbour block, see
+     *  forEachNeighbourBlock. The neighbours have to be up to date.
+     *  Inside of a parallel region this has to be called by all threads and
+     *  the blocks are distributed among them. The distribution only depends
+     *  on the amount of threads, so results are reproducible.
+     * \param f
+     *  The function to call for every block
+     */
+    template <typename F>
+    void traverseNeighbourBlocks(F&& f) {
+        if (cutoff <= 0) {
+            // the blocks get shorter with i, small chunks balance the load
+#pragma omp for schedule(static, 16)
+            for (std::size_t i = 0; i < length; i++) {
+                if (i + 1 < length) {
+                    f(i, allIndices.data() + i + 1, length - i - 1);
+                }
+            }
+        } else if (skin > 0) {
+            verlet.forEachList(f);
+        } else {
+            cells.forEachCandidateBlock(f);
+        }
+    }
+
+    /**
+     * \brief
+     *  Resizes the force arrays of the additional threads
+     * \param threads
+     *  The amount of threads
+     */
+    void prepareThreadForces(int threads);
+
+    /**
+     * \brief
+     *  Returns the force array in dimension d the given thread writes into
+     */
+    double* threadForce(int thread, int d) {
+        return thread == 0 ? forces[d].data()
+                           : threadForces[thread - 1][d].data();
+    }
+
+    /**
+     * \brief
+     *  Sets the force arrays of the given thread to 0.
+     *  Does nothing for thread 0, whose forces are reset by nextIteration.
+     */
+    void clearThreadForces(int thread);
+
+    /**
+     * \brief
+     *  Adds the force arrays of all additional threads to the forces.
+     *  Inside of a parallel region this has to be called by all threads and
+     *  the particles are distributed among them.
+     */
+    void reduceThreadForces();
 
    public:
     /**
@@ -29,8 +253,35 @@ class ParticleContainer {
      *  The amount of particles in the container
      * \param init
      * A list of particles to initialize the container with
+     * \param cutoff_
+     *  The cutoff radius, 0 disables it and all pairs will be calculated
+     * \param skin_
+     *  The skin of the Verlet lists, 0 disables them. Requires a cutoff.
+     * \param domain_
+     *  The domain, a bounded domain fixes the linked cells to it. Periodic
+     *  boundaries require a cutoff.
+     */
+    ParticleContainer(std::size_t count, std::list<Particle>& init,
+                      double cutoff_ = 0, double skin_ = 0,
+                      const Domain& domain_ = {});
+
+    /**
+     * \brief
+     *  Creates a new ParticleContainer with a given amount of particles at the
+     *  origin, at rest, without mass and of type 0. Initializers fill the
+     *  arrays afterwards, so no intermediate list is needed.
+     * \param count
+     *  The amount of particles in the container
+     * \param cutoff_
+     *  The cutoff radius, 0 disables it and all pairs will be calculated
+     * \param skin_
+     *  The skin of the Verlet lists, 0 disables them. Requires a cutoff.
+     * \param domain_
+     *  The domain, a bounded domain fixes the linked cells to it. Periodic
+     *  boundaries require a cutoff.
      */
-    ParticleContainer(std::size_t count, std::list<Particle>& init);
+    explicit ParticleContainer(std::size_t count, double cutoff_ = 0,
+                               double skin_ = 0, const Domain& domain_ = {});
 
     ParticleContainer() = default;
 
@@ -40,7 +291,91 @@ class ParticleContainer {
      */
     ~ParticleContainer() = default;
 
-    typedef std::vector<Particle>::iterator Iterator;
+    ParticleContainer(const ParticleContainer&) = default;
+    ParticleContainer& operator=(const ParticleContainer&) = default;
+    // the destructor would otherwise suppress moving
+    ParticleContainer(ParticleContainer&&) = default;
+    ParticleContainer& operator=(ParticleContainer&&) = default;
+
+    /**
+     * \brief
+     *  Random access iterator over the particles yielding ParticleRef objects
+     */
+    class Iterator {
+       private:
+        ParticleContainer* container;
+        std::size_t index;
+
+       public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = ParticleRef;
+        using difference_type = std::ptrdiff_t;
+        using reference = ParticleRef;
+
+        /**
+         * \brief
+         *  Allows it->getX() although there is no object to point to
+         */
+        struct pointer {
+            ParticleRef ref;
+            ParticleRef* operator->() { return &ref; }
+        };
+
+        Iterator(ParticleContainer& container_, std::size_t index_)
+            : container(&container_), index(index_) {}
+
+        ParticleRef operator*() const { return {*container, index}; }
+        pointer operator->() const { return {{*container, index}}; }
+        ParticleRef operator[](difference_type n) const {
+            return {*container, index + n};
+        }
+
+        Iterator& operator++() {
+            index++;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator old = *this;
+            index++;
+            return old;
+        }
+        Iterator& operator--() {
+            index--;
+            return *this;
+        }
+        Iterator operator--(int) {
+            Iterator old = *this;
+            index--;
+            return old;
+        }
+        Iterator& operator+=(difference_type n) {
+            index += n;
+            return *this;
+        }
+        Iterator& operator-=(difference_type n) {
+            index -= n;
+            return *this;
+        }
+        Iterator operator+(difference_type n) const {
+            return {*container, index + n};
+        }
+        Iterator operator-(difference_type n) const {
+            return {*container, index - n};
+        }
+        difference_type operator-(const Iterator& other) const {
+            return (difference_type)index - (difference_type)other.index;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index == other.index && container == other.container;
+        }
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+        bool operator<(const Iterator& other) const {
+            return index < other.index;
+        }
+    };
 
     /**
      * \brief
@@ -48,7 +383,7 @@ class ParticleContainer {
      * \return
      *  An iterator to the first particle in the container
      */
-    Iterator begin() { return particleArray.begin(); }
+    Iterator begin() { return {*this, 0}; }
 
     /**
      * \brief
@@ -56,7 +391,17 @@ class ParticleContainer {
      * \return
      *  An iterator to the end of the container
      */
-    Iterator end() { return particleArray.end(); }
+    Iterator end() { return {*this, length}; }
+
+    /**
+     * \brief
+     *  Returns the particle at the given index
+     * \param i
+     *  The index of the particle
+     * \return
+     *  A reference to the particle at index i
+     */
+    ParticleRef operator[](std::size_t i) { return {*this, i}; }
 
     /**
      * \brief
@@ -65,4 +410,302 @@ class ParticleContainer {
      *  The amount of particles in the container
      */
     [[nodiscard]] std::size_t size() const;
-};
\ No newline at end of file
+
+    // Raw access to the arrays, intended for kernels working on all particles
+    /**
+     * \brief
+     *  Returns the positions of all particles in dimension d
+     */
+    double* position(int d) { return positions[d].data(); }
+    [[nodiscard]] const double* position(int d) const {
+        return positions[d].data();
+    }
+
+    /**
+     * \brief
+     *  Returns the velocities of all particles in dimension d
+     */
+    double* velocity(int d) { return velocities[d].data(); }
+    [[nodiscard]] const double* velocity(int d) const {
+        return velocities[d].data();
+    }
+
+    /**
+     * \brief
+     *  Returns the forces of all particles in dimension d
+     */
+    double* force(int d) { return forces[d].data(); }
+    [[nodiscard]] const double* force(int d) const { return forces[d].data(); }
+
+    /**
+     * \brief
+     *  Returns the forces of the last iteration of all particles in dimension
+     *  d
+     */
+    double* oldForce(int d) { return oldForces[d].data(); }
+    [[nodiscard]] const double* oldForce(int d) const {
+        return oldForces[d].data();
+    }
+
+    /**
+     * \brief
+     *  Returns the masses of all particles
+     */
+    double* mass() { return masses.data(); }
+    [[nodiscard]] const double* mass() const { return masses.data(); }
+
+    /**
+     * \brief
+     *  Returns the types of all particles
+     */
+    int* type() { return types.data(); }
+    [[nodiscard]] const int* type() const { return types.data(); }
+    // End raw access
+
+    /**
+     * \brief
+     *  Replaces the particles of this container with copies of the particles
+     *  of other. The cutoff and the neighbour structures of this container
+     *  are kept. Reuses the memory of the arrays, so repeated copies of
+     *  equally sized containers do not allocate.
+     * \param other
+     *  The container to copy the particles from
+     */
+    void copyParticles(const ParticleContainer& other);
+
+    /**
+     * \brief
+     *  Prepares the particles for the next iteration by making the current
+     *  force the old force and setting the current force to {0,0,0}
+     */
+    void nextIteration();
+
+    /**
+     * \brief
+     *  Prepares the particles for the next iteration like nextIteration, if
+     *  the caller already set the old forces to {0,0,0} in its own pass over
+     *  the particles. Swaps them with the current forces, and the next call
+     *  of nextIteration by the force calculation does nothing, so the forces
+     *  are not streamed through the cache again.
+     */
+    void swapClearedForces();
+
+    /**
+     * \brief
+     *  Makes the next call of nextIteration by the force calculation do
+     *  nothing, so the next force is added to the current forces. Used to
+     *  sum up several forces.
+     */
+    void keepForces();
+
+    /**
+     * \brief
+     *  Multiplies the forces of all particles with the factor
+     * \param factor
+     *  The factor of the forces
+     */
+    void scaleForces(double factor);
+
+    /**
+     * \brief
+     *  Removes the marked particles in a single compaction pass. The
+     *  remaining particles keep their order, so indices only shift down.
+     *  The Verlet lists are renumbered instead of rebuilt. Must not be
+     *  called while the neighbours are traversed.
+     * \param remove
+     *  For every particle if it should be removed, at least size() entries
+     * \return
+     *  The amount of removed particles
+     */
+    std::size_t removeParticles(const std::vector<char>& remove);
+
+    /**
+     * \brief
+     *  Sorts the particles along a Morton curve of the cells they are
+     *  located in, so particles close in space are close in memory and the
+     *  pair loops hit the cache. The cells are cutoff plus skin wide, without
+     *  a cutoff the bounding box is divided into 1024 cells per dimension.
+     *  The Verlet lists are renumbered instead of rebuilt. Must not be called
+     *  while the neighbours are traversed.
+     */
+    void reorder();
+
+    /**
+     * \brief
+     *  Applies the reflecting and outflow boundaries of the domain after the
+     *  particles moved. Reflected particles are mirrored at the face and
+     *  their velocity orthogonal to it is inverted. Particles outside of an
+     *  outflow face are removed, see removeParticles.
+     *  Periodic boundaries are applied when the neighbours are updated.
+     * \return
+     *  The amount of removed particles
+     */
+    std::size_t applyBoundaries();
+
+    /**
+     * \brief
+     *  Returns the cutoff radius, 0 if it is disabled.
+     * \return
+     *  The cutoff radius
+     */
+    [[nodiscard]] double getCutoff() const;
+
+    /**
+     * \brief
+     *  Returns the skin of the Verlet lists, 0 if they are disabled.
+     * \return
+     *  The skin of the Verlet lists
+     */
+    [[nodiscard]] double getSkin() const;
+
+    /**
+     * \brief
+     *  Returns the domain of the container.
+     * \return
+     *  The domain, unbounded if none was set
+     */
+    [[nodiscard]] const Domain& getDomain() const;
+
+    /**
+     * \brief
+     *  Returns the particle a neighbour index refers to. Neighbour blocks
+     *  can contain ghosts with indices from size() on.
+     * \param j
+     *  An index of a particle or a ghost
+     * \return
+     *  j for particles, the index of the original particle for ghosts
+     */
+    [[nodiscard]] std::size_t originOf(std::size_t j) const;
+
+    /**
+     * \brief
+     *  Returns how often the Verlet lists have been built.
+     * \return
+     *  The amount of rebuilds, 0 if Verlet lists are disabled
+     */
+    [[nodiscard]] std::size_t getRebuildCount() const;
+
+    /**
+     * \brief
+     *  Returns the positions the particles had in dimension d when the Verlet
+     *  lists were built.
+     *  After moving particles, the largest squared distance to these has to
+     *  be reported with updateDisplacement.
+     * \param d
+     *  The dimension (0, 1 or 2)
+     * \return
+     *  The reference positions, nullptr if the displacement is not needed
+     */
+    [[nodiscard]] const double* getReferencePosition(int d) const;
+
+    /**
+     * \brief
+     *  Reports how far particles moved, so the Verlet lists can detect when
+     *  they become outdated.
+     * \param displacementSq
+     *  The largest squared distance of a particle to its reference position
+     */
+    void updateDisplacement(double displacementSq);
+
+    /**
+     * \brief
+     *  Calls f(i, neighbours, count) with blocks of particle indices that
+     *  might interact with particle i. Every unordered pair of interacting
+     *  particles is contained exactly once.
+     *  Without a cutoff these are all pairs. Otherwise the blocks are found
+     *  with the linked cells, which are rebuilt every time, or with the
+     *  Verlet lists, which are only rebuilt if a particle moved further than
+     *  half of the skin. The blocks may then contain particles further apart
+     *  than the cutoff, which have to be filtered by the caller.
+     *  With periodic boundaries the blocks contain ghosts, see originOf. Their
+     *  positions are valid during the call, forces written to them are lost.
+     * \param f
+     *  The function to call for every block
+     */
+    template <typename F>
+    void forEachNeighbourBlock(F&& f) {
+        updateNeighbours();
+        traverseNeighbourBlocks(f);
+    }
+
+    /**
+     * \brief
+     *  Visits the same blocks as forEachNeighbourBlock, but distributes them
+     *  among all threads.
+     *  Newton's third law writes to the forces of both particles of a pair,
+     *  so every thread accumulates into its own force arrays, which are
+     *  added up at the end. No atomics or locks are needed.
+     *
+     *  makeBlockFunction(fx, fy, fz) is called once per thread with the force
+     *  arrays of that thread and has to return the function, which is
+     *  called with (i, neighbours, count) for the blocks of that thread.
+     *  It must only write forces into the given arrays.
+     *  After the call the forces of the container contain the sum of all
+     *  threads, including the forces on the ghosts of the particles.
+     *  The forces are not reset before, see nextIteration.
+     *  The arrays may be reallocated before the first call of
+     *  makeBlockFunction, so pointers to them have to be obtained inside.
+     * \param makeBlockFunction
+     *  Creates the function to call for every block of a thread
+     */
+    template <typename MakeBlockF>
+    void forEachNeighbourBlockParallel(MakeBlockF&& makeBlockFunction) {
+        updateNeighbours();
+        prepareThreadForces(threads::count());
+
+#pragma omp parallel
+        {
+            const int thread = threads::index();
+            clearThreadForces(thread);
+
+            auto f = makeBlockFunction(threadForce(thread, 0),
+                                       threadForce(thread, 1),
+                                       threadForce(thread, 2));
+            // ends with a barrier, so all threads are done before the
+            // reduction
+            traverseNeighbourBlocks(f);
+            reduceThreadForces();
+        }
+
+        foldGhostForces();
+    }
+
+    /**
+     * \brief
+     *  Builds the octree from the current positions and masses.
+     *  The octree ignores the cutoff.
+     * \return
+     *  The octree containing all particles
+     */
+    const Octree& buildOctree();
+
+    /**
+     * \brief
+     *  Calls f(i, j) for every unordered pair of particle indices that
+     *  interact. Without a cutoff these are all pairs, otherwise only pairs
+     *  closer than the cutoff are visited. j can be a ghost, see originOf.
+     * \param f
+     *  The function to call for every pair
+     */
+    template <typename F>
+    void forEachPair(F&& f) {
+        double cutoff_sq = cutoff > 0 ? cutoff * cutoff
+                                      : std::numeric_limits<double>::max();
+        updateNeighbours();
+        const double* x = position(0);
+        const double* y = position(1);
+        const double* z = position(2);
+        traverseNeighbourBlocks(
+            [&](std::size_t i, const std::size_t* block, std::size_t count) {
+                for (std::size_t k = 0; k < count; k++) {
+                    std::size_t j = block[k];
+                    double dx = x[i] - x[j];
+                    double dy = y[i] - y[j];
+                    double dz = z[i] - z[j];
+                    if (dx * dx + dy * dy + dz * dz <= cutoff_sq) {
+                        f(i, j);
+                    }
+                }
+            });
+    }
+};
@@ -0,0 +1,60 @@
+#include "ParticleRef.h"
+
+#include <sstream>
+
+#include "ParticleContainer.h"
+#include "utils/ArrayUtils.h"
+
+ParticleRef::ParticleRef(ParticleContainer& container_, std::size_t index_)
+    : container(&container_), index(index_) {}
+
+std::array<double, 3> ParticleRef::getX() const {
+    return {container->position(0)[index], container->position(1)[index],
+            container->position(2)[index]};
+}
+
+std::array<double, 3> ParticleRef::getV() const {
+    return {container->velocity(0)[index], container->velocity(1)[index],
+            container->velocity(2)[index]};
+}
+
+std::array<double, 3> ParticleRef::getF() const {
+    return {container->force(0)[index], container->force(1)[index],
+            container->force(2)[index]};
+}
+
+std::array<double, 3> ParticleRef::getOldF() const {
+    return {container->oldForce(0)[index], container->oldForce(1)[index],
+            container->oldForce(2)[index]};
+}
+
+double ParticleRef::getM() const { return container->mass()[index]; }
+
+int ParticleRef::getType() const { return container->type()[index]; }
+
+std::size_t ParticleRef::getIndex() const { return index; }
+
+void ParticleRef::addF(const std::array<double, 3>& aF) {
+    for (int d = 0; d < 3; d++) {
+        container->force(d)[index] += aF[d];
+    }
+}
+
+void ParticleRef::addX(const std::array<double, 3>& aX) {
+    for (int d = 0; d < 3; d++) {
+        container->position(d)[index] += aX[d];
+    }
+}
+
+void ParticleRef::addV(const std::array<double, 3>& aV) {
+    for (int d = 0; d < 3; d++) {
+        container->velocity(d)[index] += aV[d];
+    }
+}
+
+std::string ParticleRef::toString() const {
+    std::stringstream stream;
+    stream << "Particle: X:" << getX() << " v: " << getV() << " f: " << getF()
+           << " old_f: " << getOldF() << " type: " << getType();
+    return stream.str();
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+class ParticleContainer;
+
+/**
+ * \brief
+ *  A reference to a single particle inside of a ParticleContainer.
+ *  The container stores every component in its own array, so there is no
+ *  Particle object to point to. This class offers the interface of Particle
+ *  for code that works on single particles, like the output writers.
+ *
+ *  The reference stays valid as long as the container is not resized.
+ */
+class ParticleRef {
+   private:
+    /**
+     * The container holding the particle
+     */
+    ParticleContainer* container;
+
+    /**
+     * The index of the particle inside of the container
+     */
+    std::size_t index;
+
+   public:
+    /**
+     * \brief
+     *  Creates a reference to a particle
+     * \param container_
+     *  The container holding the particle
+     * \param index_
+     *  The index of the particle inside of the container
+     */
+    ParticleRef(ParticleContainer& container_, std::size_t index_);
+
+    /**
+     * \brief
+     *  Returns the position of the particle
+     */
+    [[nodiscard]] std::array<double, 3> getX() const;
+
+    /**
+     * \brief
+     *  Returns the velocity of the particle
+     */
+    [[nodiscard]] std::array<double, 3> getV() const;
+
+    /**
+     * \brief
+     *  Returns the force of the particle
+     */
+    [[nodiscard]] std::array<double, 3> getF() const;
+
+    /**
+     * \brief
+     *  Returns the old force of the particle
+     */
+    [[nodiscard]] std::array<double, 3> getOldF() const;
+
+    /**
+     * \brief
+     *  Returns the mass of the particle
+     */
+    [[nodiscard]] double getM() const;
+
+    /**
+     * \brief
+     *  Returns the type of the particle
+     */
+    [[nodiscard]] int getType() const;
+
+    /**
+     * \brief
+     *  Returns the index of the particle inside of the container
+     */
+    [[nodiscard]] std::size_t getIndex() const;
+
+    /**
+     * \brief
+     *  Adds the given force to the current force
+     */
+    void addF(const std::array<double, 3>& aF);
+
+    /**
+     * \brief
+     *  Adds the given position to the current position
+     */
+    void addX(const std::array<double, 3>& aX);
+
+    /**
+     * \brief
+     *  Adds the given speed to the current speed
+     */
+    void addV(const std::array<double, 3>& aV);
+
+    /**
+     * \brief
+     *  Converts the particle to a string
+     */
+    [[nodiscard]] std::string toString() const;
+};
@@ -0,0 +1,101 @@
+#include "VerletList.h"
+
+#include <algorithm>
+
+VerletList::VerletList(double skin_) : skin(skin_) {}
+
+void VerletList::build(const LinkedCells& cells, const double* x,
+                       const double* y, const double* z, std::size_t count,
+                       double cutoff) {
+    double radius_sq = (cutoff + skin) * (cutoff + skin);
+
+    neighbourOffset.assign(count, 0);
+    neighbourCount.assign(count, 0);
+    neighbours.clear();
+
+    // the cells visit all candidates of a particle consecutively, so the list
+    // of a particle is always one contiguous block
+    cells.forEachCandidatePair([&](std::size_t i, std::size_t j) {
+        double dx = x[i] - x[j];
+        double dy = y[i] - y[j];
+        double dz = z[i] - z[j];
+        if (dx * dx + dy * dy + dz * dz <= radius_sq) {
+            if (neighbourCount[i] == 0) {
+                neighbourOffset[i] = neighbours.size();
+            }
+            neighbours.push_back(j);
+            neighbourCount[i]++;
+        }
+    });
+
+    std::array<const double*, 3> positions = {x, y, z};
+    for (int d = 0; d < 3; d++) {
+        reference[d].assign(positions[d], positions[d] + count);
+    }
+
+    maxDisplacementSq = 0;
+    invalid = false;
+    rebuilds++;
+}
+
+const double* VerletList::getReference(int d) const {
+    // there are no reference positions before the first build
+    return invalid ? nullptr : reference[d].data();
+}
+
+void VerletList::updateDisplacement(double displacementSq) {
+    maxDisplacementSq = std::max(maxDisplacementSq, displacementSq);
+}
+
+void VerletList::invalidate() { invalid = true; }
+
+void VerletList::renumber(const std::vector<std::size_t>& newIndex,
+                          std::size_t count) {
+    if (invalid) {
+        return;
+    }
+
+    std::vector<std::size_t> oldIndex(count);
+    for (std::size_t i = 0; i < newIndex.size(); i++) {
+        if (newIndex[i] != LinkedCells::REMOVED) {
+            oldIndex[newIndex[i]] = i;
+        }
+    }
+
+    // the lists are copied in the new order, so they stay contiguous
+    std::vector<std::size_t> kept;
+    kept.reserve(neighbours.size());
+    std::vector<std::size_t> offsets(count, 0);
+    std::vector<std::size_t> counts(count, 0);
+    std::array<AlignedVector<double>, 3> newReference;
+    for (int d = 0; d < 3; d++) {
+        newReference[d].resize(count);
+    }
+    for (std::size_t newI = 0; newI < count; newI++) {
+        const std::size_t i = oldIndex[newI];
+        offsets[newI] = kept.size();
+        for (std::size_t k = neighbourOffset[i];
+             k < neighbourOffset[i] + neighbourCount[i]; k++) {
+            const std::size_t newJ = newIndex[neighbours[k]];
+            if (newJ != LinkedCells::REMOVED) {
+                kept.push_back(newJ);
+            }
+        }
+        counts[newI] = kept.size() - offsets[newI];
+        for (int d = 0; d < 3; d++) {
+            newReference[d][newI] = reference[d][i];
+        }
+    }
+
+    neighbours.swap(kept);
+    neighbourOffset.swap(offsets);
+    neighbourCount.swap(counts);
+    reference.swap(newReference);
+}
+
+bool VerletList::needsRebuild() const {
+    // moved further than skin / 2
+    return invalid || 4 * maxDisplacementSq > skin * skin;
+}
+
+std::size_t VerletList::getRebuildCount() const { return rebuilds; }
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "LinkedCells.h"
+#include "utils/AlignedAllocator.h"
+
+/**
+ * \brief
+ *  Stores for every particle the particles within the cutoff radius plus a
+ *  skin.
+ *  As long as no particle has moved further than half of the skin since the
+ *  lists were built, every pair inside of the cutoff is still contained, so
+ *  the lists can be reused for multiple iterations.
+ *
+ *  Every pair is stored only once (half lists).
+ */
+class VerletList {
+   private:
+    /**
+     * \brief
+     *  The width of the additional shell around the cutoff radius
+     */
+    double skin;
+
+    /**
+     * \brief
+     *  For every particle the index of its first neighbour in neighbours
+     */
+    std::vector<std::size_t> neighbourOffset;
+
+    /**
+     * \brief
+     *  For every particle the amount of its neighbours
+     */
+    std::vector<std::size_t> neighbourCount;
+
+    /**
+     * \brief
+     *  The neighbour indices of all particles
+     */
+    std::vector<std::size_t> neighbours;
+
+    /**
+     * \brief
+     *  The positions of the particles when the lists were built, one array
+     *  per dimension
+     */
+    std::array<AlignedVector<double>, 3> reference;
+
+    /**
+     * \brief
+     *  The largest squared distance a particle moved since the lists were
+     *  built
+     */
+    double maxDisplacementSq = 0;
+
+    /**
+     * \brief
+     *  True if the lists have to be rebuilt independent of the displacement
+     */
+    bool invalid = true;
+
+    /**
+     * \brief
+     *  How often the lists have been built
+     */
+    std::size_t rebuilds = 0;
+
+   public:
+    /**
+     * \brief
+     *  Creates empty lists, these have to be built before using them
+     * \param skin_
+     *  The width of the additional shell around the cutoff radius
+     */
+    explicit VerletList(double skin_ = 0);
+
+    /**
+     * \brief
+     *  Builds the lists from the candidate pairs of the linked cells
+     * \param cells
+     *  The linked cells, already rebuilt with a cell size of at least
+     *  cutoff + skin
+     * \param x
+     *  The x coordinates of the particles the cells were built from
+     * \param y
+     *  The y coordinates of the particles the cells were built from
+     * \param z
+     *  The z coordinates of the particles the cells were built from
+     * \param count
+     *  The amount of particles
+     * \param cutoff
+     *  The cutoff radius
+     */
+    void build(const LinkedCells& cells, const double* x, const double* y,
+               const double* z, std::size_t count, double cutoff);
+
+    /**
+     * \brief
+     *  Returns the positions of the particles in dimension d when the lists
+     *  were built, nullptr if the lists have not been built yet.
+     * \param d
+     *  The dimension (0, 1 or 2)
+     */
+    [[nodiscard]] const double* getReference(int d) const;
+
+    /**
+     * \brief
+     *  Updates the maximum displacement since the lists were built.
+     *  Has to be called whenever particles moved.
+     * \param displacementSq
+     *  The largest squared distance of a particle to its reference position
+     */
+    void updateDisplacement(double displacementSq);
+
+    /**
+     * \brief
+     *  Forces a rebuild before the lists are used the next time
+     */
+    void invalidate();
+
+    /**
+     * \brief
+     *  Renumbers the particles after they were reordered or removed, which
+     *  is much cheaper than a rebuild. The lists of removed particles and
+     *  the pairs with them are dropped, the lists are stored in the new order.
+     *  Does nothing if the lists are invalid.
+     * \param newIndex
+     *  For every particle of the lists its new index or LinkedCells::REMOVED
+     * \param count
+     *  The amount of particles afterwards
+     */
+    void renumber(const std::vector<std::size_t>& newIndex, std::size_t count);
+
+    /**
+     * \brief
+     *  Checks if a particle might have moved further than half of the skin
+     * \return
+     *  True if the lists have to be rebuilt
+     */
+    [[nodiscard]] bool needsRebuild() const;
+
+    /**
+     * \brief
+     *  Returns how often the lists have been built
+     */
+    [[nodiscard]] std::size_t getRebuildCount() const;
+
+    /**
+     * \brief
+     *  Calls f(i, neighbours, count) for every particle i with its list.
+     *  Pairs may be further apart than the cutoff and have to be filtered by
+     *  the caller.
+     *  Inside of a parallel region this has to be called by all threads and
+     *  the lists are distributed among them.
+     * \param f
+     *  The function to call for every list
+     */
+    template <typename F>
+    void forEachList(F&& f) const {
+#pragma omp for schedule(static, 64)
+        for (std::size_t i = 0; i < neighbourOffset.size(); i++) {
+            if (neighbourCount[i] > 0) {
+                f(i, neighbours.data() + neighbourOffset[i], neighbourCount[i]);
+            }
+        }
+    }
+};
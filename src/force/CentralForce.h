@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+
+#include "Force.h"
+#include "utils/ArrayUtils.h"
+
+/* Interface for central pair forces
+ *
+ * The force on p1 is a scalar multiple of the distance vector x1 - x2, which
+ * only depends on the distance and the masses. Implementations provide this
+ * scalar, which can be evaluated directly on the particle arrays of the
+ * container.
+ *
+ * The forces shipped with the simulation are final and define the scalar
+ * inline, so the templated force calculation can inline them into the pair
+ * loop. Other implementations are called through the virtual interface.
+ */
+class CentralForce : public Force {
+   public:
+    /**
+     *  \brief
+     *  Destructor
+     */
+    ~CentralForce() override = default;
+
+    /**
+     *  \brief
+     *  Calculates the force between two particles from the scalar
+     *
+     *  \param p1
+     *  The first particle
+     *
+     *  \param p2
+     *  The second particle
+     *
+     *  \return
+     *  The force vector between the two particles
+     */
+    std::array<double, 3> calculateForce(Particle &p1,
+                                         Particle &p2) const override {
+        std::array<double, 3> diff = p1.getX() - p2.getX();
+        double distanceSq =
+            diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
+        return calculateScalar(distanceSq, p1.getM(), p2.getM()) * diff;
+    }
+
+    /**
+     *  \brief
+     *  Calculates the scalar s, so that the force on the first particle is
+     *  s * (x1 - x2) and the force on the second one -s * (x1 - x2)
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \param m1
+     *  The mass of the first particle
+     *
+     *  \param m2
+     *  The mass of the second particle
+     *
+     *  \return
+     *  The scalar factor of the force
+     */
+    virtual double calculateScalar(double distanceSq, double m1,
+                                   double m2) const = 0;
+};
@@ -3,8 +3,14 @@
 #include <container/Particle.h>
 
 #include <array>
+#include <string>
 
 /* Interface for the force calculation
+ *
+ * Implementations only have to provide the force between two particles.
+ * Central pair forces should derive from CentralForce instead, which the
+ * force calculation can evaluate directly on the particle arrays of the
+ * container.
  */
 class Force {
    public:
@@ -37,4 +43,4 @@ class Force {
      *  A string representation of the force
      */
     virtual std::string typeString() = 0;
-};
\ No newline at end of file
+};
@@ -0,0 +1,290 @@
+#include "LennardJonesKernel.h"
+
+#include <immintrin.h>
+
+#include <cstdint>
+
+// the kernels load the neighbour indices directly as 64 bit integers
+static_assert(sizeof(std::size_t) == sizeof(std::int64_t),
+              "The SIMD kernels require a 64 bit std::size_t");
+
+namespace ljkernel {
+
+namespace {
+/**
+ * Calculates the pairs [first, count) one at a time and adds the force on
+ * particle i to fix, fiy and fiz, used by the AVX2 kernel for the remainder.
+ * With Mixture the parameters of every pair are looked up by the types.
+ */
+template <bool Mixture>
+inline void scalarPairs(const LJKernelData& data, std::size_t i,
+                        const std::size_t* neighbours, std::size_t first,
+                        std::size_t count, double& fix, double& fiy,
+                        double& fiz) {
+    const double xi = data.x[i];
+    const double yi = data.y[i];
+    const double zi = data.z[i];
+    // the row of the tables belonging to the type of i
+    const std::size_t row = Mixture ? (std::size_t)data.type[i] * data.types : 0;
+
+    for (std::size_t k = first; k < count; k++) {
+        const std::size_t j = neighbours[k];
+        const double dx = xi - data.x[j];
+        const double dy = yi - data.y[j];
+        const double dz = zi - data.z[j];
+        const double distanceSq = dx * dx + dy * dy + dz * dz;
+
+        if (distanceSq > data.cutoff_sq) {
+            continue;
+        }
+
+        double epsilon_24 = data.epsilon_24;
+        double sigma_sq = data.sigma_sq;
+        if constexpr (Mixture) {
+            epsilon_24 = data.epsilon_24_table[row + data.type[j]];
+            sigma_sq = data.sigma_sq_table[row + data.type[j]];
+        }
+
+        const double inv_sq = 1. / distanceSq;
+        const double summand_2 = sigma_sq * inv_sq;
+        const double summand_6 = summand_2 * summand_2 * summand_2;
+        const double s =
+            epsilon_24 * inv_sq * (summand_6 - 2 * summand_6 * summand_6);
+
+        fix += s * dx;
+        fiy += s * dy;
+        fiz += s * dz;
+        data.fx[j] -= s * dx;
+        data.fy[j] -= s * dy;
+        data.fz[j] -= s * dz;
+    }
+}
+
+template <bool Mixture>
+__attribute__((target("avx2,fma"))) void avx2Block(
+    const LJKernelData& data, std::size_t i, const std::size_t* neighbours,
+    std::size_t count) {
+    const __m256d xi = _mm256_set1_pd(data.x[i]);
+    const __m256d yi = _mm256_set1_pd(data.y[i]);
+    const __m256d zi = _mm256_set1_pd(data.z[i]);
+    const __m256d epsilon_24 = _mm256_set1_pd(data.epsilon_24);
+    const __m256d sigma_sq = _mm256_set1_pd(data.sigma_sq);
+    const __m256d cutoff_sq = _mm256_set1_pd(data.cutoff_sq);
+    const __m256d one = _mm256_set1_pd(1.);
+    const __m256d two = _mm256_set1_pd(2.);
+    // the rows of the tables belonging to the type of i
+    const std::size_t row = Mixture ? (std::size_t)data.type[i] * data.types : 0;
+    const double* epsilon_24_row = data.epsilon_24_table + row;
+    const double* sigma_sq_row = data.sigma_sq_table + row;
+
+    __m256d fix = _mm256_setzero_pd();
+    __m256d fiy = _mm256_setzero_pd();
+    __m256d fiz = _mm256_setzero_pd();
+
+    alignas(32) double fjx[4];
+    alignas(32) double fjy[4];
+    alignas(32) double fjz[4];
+
+    std::size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const __m256i index =
+            _mm256_loadu_si256((const __m256i*)(neighbours + k));
+        const __m256d dx = _mm256_sub_pd(xi, _mm256_i64gather_pd(data.x, index, 8));
+        const __m256d dy = _mm256_sub_pd(yi, _mm256_i64gather_pd(data.y, index, 8));
+        const __m256d dz = _mm256_sub_pd(zi, _mm256_i64gather_pd(data.z, index, 8));
+
+        const __m256d distanceSq = _mm256_fmadd_pd(
+            dx, dx, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dz, dz)));
+
+        __m256d pair_epsilon_24 = epsilon_24;
+        __m256d pair_sigma_sq = sigma_sq;
+        if constexpr (Mixture) {
+            // the masked gathers with all lanes set, as the unmasked ones
+            // trigger false uninitialized warnings in GCC
+            const __m128i type_j = _mm256_mask_i64gather_epi32(
+                _mm_setzero_si128(), data.type, index, _mm_set1_epi32(-1), 4);
+            const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            pair_epsilon_24 = _mm256_mask_i32gather_pd(
+                _mm256_setzero_pd(), epsilon_24_row, type_j, all, 8);
+            pair_sigma_sq = _mm256_mask_i32gather_pd(
+                _mm256_setzero_pd(), sigma_sq_row, type_j, all, 8);
+        }
+
+        const __m256d inv_sq = _mm256_div_pd(one, distanceSq);
+        const __m256d summand_2 = _mm256_mul_pd(pair_sigma_sq, inv_sq);
+        const __m256d summand_6 =
+            _mm256_mul_pd(_mm256_mul_pd(summand_2, summand_2), summand_2);
+        // s6 - 2 * s6 * s6
+        const __m256d bracket = _mm256_fnmadd_pd(
+            _mm256_mul_pd(two, summand_6), summand_6, summand_6);
+        __m256d s =
+            _mm256_mul_pd(_mm256_mul_pd(pair_epsilon_24, inv_sq), bracket);
+
+        // pairs outside of the cutoff get a scalar of 0
+        s = _mm256_and_pd(s, _mm256_cmp_pd(distanceSq, cutoff_sq, _CMP_LE_OQ));
+
+        const __m256d fx = _mm256_mul_pd(s, dx);
+        const __m256d fy = _mm256_mul_pd(s, dy);
+        const __m256d fz = _mm256_mul_pd(s, dz);
+        fix = _mm256_add_pd(fix, fx);
+        fiy = _mm256_add_pd(fiy, fy);
+        fiz = _mm256_add_pd(fiz, fz);
+
+        // AVX2 has no scatter, the neighbours are updated one by one
+        _mm256_store_pd(fjx, fx);
+        _mm256_store_pd(fjy, fy);
+        _mm256_store_pd(fjz, fz);
+        for (int l = 0; l < 4; l++) {
+            const std::size_t j = neighbours[k + l];
+            data.fx[j] -= fjx[l];
+            data.fy[j] -= fjy[l];
+            data.fz[j] -= fjz[l];
+        }
+    }
+
+    // horizontal sums of the force on i
+    alignas(32) double sum[4];
+    double fi[3] = {0, 0, 0};
+    const __m256d parts[3] = {fix, fiy, fiz};
+    for (int d = 0; d < 3; d++) {
+        _mm256_store_pd(sum, parts[d]);
+        fi[d] = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+    }
+
+    scalarPairs<Mixture>(data, i, neighbours, k, count, fi[0], fi[1], fi[2]);
+    data.fx[i] += fi[0];
+    data.fy[i] += fi[1];
+    data.fz[i] += fi[2];
+}
+
+template <bool Mixture>
+__attribute__((target("avx512f"))) void avx512Block(
+    const LJKernelData& data, std::size_t i, const std::size_t* neighbours,
+    std::size_t count) {
+    const __m512d xi = _mm512_set1_pd(data.x[i]);
+    const __m512d yi = _mm512_set1_pd(data.y[i]);
+    const __m512d zi = _mm512_set1_pd(data.z[i]);
+    const __m512d epsilon_24 = _mm512_set1_pd(data.epsilon_24);
+    const __m512d sigma_sq = _mm512_set1_pd(data.sigma_sq);
+    const __m512d cutoff_sq = _mm512_set1_pd(data.cutoff_sq);
+    const __m512d one = _mm512_set1_pd(1.);
+    const __m512d two = _mm512_set1_pd(2.);
+    const __m512d zero = _mm512_setzero_pd();
+    // the rows of the tables belonging to the type of i
+    const std::size_t row = Mixture ? (std::size_t)data.type[i] * data.types : 0;
+    const double* epsilon_24_row = data.epsilon_24_table + row;
+    const double* sigma_sq_row = data.sigma_sq_table + row;
+
+    __m512d fix = zero;
+    __m512d fiy = zero;
+    __m512d fiz = zero;
+
+    // the last iteration is masked, so there is no scalar remainder
+    for (std::size_t k = 0; k < count; k += 8) {
+        const __mmask8 lanes =
+            count - k >= 8 ? (__mmask8)0xFF
+                           : (__mmask8)((1u << (count - k)) - 1);
+        const __m512i index =
+            _mm512_maskz_loadu_epi64(lanes, (const void*)(neighbours + k));
+
+        const __m512d dx = _mm512_sub_pd(
+            xi, _mm512_mask_i64gather_pd(zero, lanes, index, data.x, 8));
+        const __m512d dy = _mm512_sub_pd(
+            yi, _mm512_mask_i64gather_pd(zero, lanes, index, data.y, 8));
+        const __m512d dz = _mm512_sub_pd(
+            zi, _mm512_mask_i64gather_pd(zero, lanes, index, data.z, 8));
+
+        // unused lanes get a distance of 1 to avoid dividing by 0
+        const __m512d distanceSq = _mm512_mask_blend_pd(
+            lanes, one,
+            _mm512_fmadd_pd(dx, dx,
+                            _mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dz, dz))));
+
+        __m512d pair_epsilon_24 = epsilon_24;
+        __m512d pair_sigma_sq = sigma_sq;
+        if constexpr (Mixture) {
+            // unused lanes get parameters of 1 and are masked out later
+            const __m256i type_j = _mm512_mask_i64gather_epi32(
+                _mm256_setzero_si256(), lanes, index, data.type, 4);
+            pair_epsilon_24 = _mm512_mask_i32gather_pd(
+                one, lanes, type_j, epsilon_24_row, 8);
+            pair_sigma_sq =
+                _mm512_mask_i32gather_pd(one, lanes, type_j, sigma_sq_row, 8);
+        }
+
+        const __m512d inv_sq = _mm512_div_pd(one, distanceSq);
+        const __m512d summand_2 = _mm512_mul_pd(pair_sigma_sq, inv_sq);
+        const __m512d summand_6 =
+            _mm512_mul_pd(_mm512_mul_pd(summand_2, summand_2), summand_2);
+        const __m512d bracket = _mm512_fnmadd_pd(
+            _mm512_mul_pd(two, summand_6), summand_6, summand_6);
+
+        // pairs outside of the cutoff and unused lanes get a scalar of 0
+        const __mmask8 inside =
+            _mm512_mask_cmp_pd_mask(lanes, distanceSq, cutoff_sq, _CMP_LE_OQ);
+        const __m512d s = _mm512_maskz_mul_pd(
+            inside, _mm512_mul_pd(pair_epsilon_24, inv_sq), bracket);
+
+        const __m512d fx = _mm512_mul_pd(s, dx);
+        const __m512d fy = _mm512_mul_pd(s, dy);
+        const __m512d fz = _mm512_mul_pd(s, dz);
+        fix = _mm512_add_pd(fix, fx);
+        fiy = _mm512_add_pd(fiy, fy);
+        fiz = _mm512_add_pd(fiz, fz);
+
+        // the neighbours are unique, so the scatters can not conflict
+        _mm512_mask_i64scatter_pd(
+            data.fx, inside, index,
+            _mm512_sub_pd(
+                _mm512_mask_i64gather_pd(zero, inside, index, data.fx, 8), fx),
+            8);
+        _mm512_mask_i64scatter_pd(
+            data.fy, inside, index,
+            _mm512_sub_pd(
+                _mm512_mask_i64gather_pd(zero, inside, index, data.fy, 8), fy),
+            8);
+        _mm512_mask_i64scatter_pd(
+            data.fz, inside, index,
+            _mm512_sub_pd(
+                _mm512_mask_i64gather_pd(zero, inside, index, data.fz, 8), fz),
+            8);
+    }
+
+    // horizontal sums of the force on i
+    alignas(64) double sum[8];
+    double* fi[3] = {data.fx + i, data.fy + i, data.fz + i};
+    const __m512d parts[3] = {fix, fiy, fiz};
+    for (int d = 0; d < 3; d++) {
+        _mm512_store_pd(sum, parts[d]);
+        *fi[d] += ((sum[0] + sum[1]) + (sum[2] + sum[3])) +
+                  ((sum[4] + sum[5]) + (sum[6] + sum[7]));
+    }
+}
+
+}  // namespace
+
+__attribute__((target("avx2,fma"))) void blockAVX2(
+    const LJKernelData& data, std::size_t i, const std::size_t* neighbours,
+    std::size_t count) {
+    avx2Block<false>(data, i, neighbours, count);
+}
+
+__attribute__((target("avx512f"))) void blockAVX512(
+    const LJKernelData& data, std::size_t i, const std::size_t* neighbours,
+    std::size_t count) {
+    avx512Block<false>(data, i, neighbours, count);
+}
+
+__attribute__((target("avx2,fma"))) void mixtureAVX2(
+    const LJKernelData& data, std::size_t i, const std::size_t* neighbours,
+    std::size_t count) {
+    avx2Block<true>(data, i, neighbours, count);
+}
+
+__attribute__((target("avx512f"))) void mixtureAVX512(
+    const LJKernelData& data, std::size_t i, const std::size_t* neighbours,
+    std::size_t count) {
+    avx512Block<true>(data, i, neighbours, count);
+}
+
+}  // namespace ljkernel
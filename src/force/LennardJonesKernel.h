@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+
+#include "utils/Simd.h"
+
+/**
+ * \brief
+ *  The particle arrays and constants the Lennard-Jones kernels work on
+ */
+struct LJKernelData {
+    /** The positions of all particles, one array per dimension */
+    const double* x;
+    const double* y;
+    const double* z;
+
+    /** The forces of all particles, one array per dimension */
+    double* fx;
+    double* fy;
+    double* fz;
+
+    /** The epsilon parameter times -24 */
+    double epsilon_24;
+
+    /** The sigma parameter squared */
+    double sigma_sq;
+
+    /** The squared cutoff radius, pairs further apart do not interact */
+    double cutoff_sq;
+
+    /**
+     * The types of all particles, only used by the mixture kernels, which
+     * look up the parameters of a pair instead of using epsilon_24 and
+     * sigma_sq
+     */
+    const int* type = nullptr;
+
+    /** The epsilon parameters times -24 of every pair of types */
+    const double* epsilon_24_table = nullptr;
+
+    /** The sigma parameters squared of every pair of types */
+    const double* sigma_sq_table = nullptr;
+
+    /** The amount of types, the tables are indexed by type_i * types + type_j */
+    int types = 0;
+};
+
+/**
+ * \brief
+ *  Calculates the Lennard-Jones forces between particle i and a block of
+ *  neighbours and adds them to both (Newton's third law).
+ *  The neighbours have to be unique and must not contain i.
+ */
+using LJBlockKernel = void (*)(const LJKernelData& data, std::size_t i,
+                               const std::size_t* neighbours,
+                               std::size_t count);
+
+namespace ljkernel {
+
+/**
+ * \brief
+ *  Processes 4 pairs per instruction using AVX2 gathers and FMA.
+ *  Must only be called if simd::isSupported(SimdLevel::avx2).
+ */
+void blockAVX2(const LJKernelData& data, std::size_t i,
+               const std::size_t* neighbours, std::size_t count);
+
+/**
+ * \brief
+ *  Processes 8 pairs per instruction using AVX-512 gathers and scatters.
+ *  Must only be called if simd::isSupported(SimdLevel::avx512).
+ */
+void blockAVX512(const LJKernelData& data, std::size_t i,
+                 const std::size_t* neighbours, std::size_t count);
+
+/**
+ * \brief
+ *  Like blockAVX2, but gathers the parameters of every pair by the types of
+ *  the particles.
+ *  Must only be called if simd::isSupported(SimdLevel::avx2).
+ */
+void mixtureAVX2(const LJKernelData& data, std::size_t i,
+                 const std::size_t* neighbours, std::size_t count);
+
+/**
+ * \brief
+ *  Like blockAVX512, but gathers the parameters of every pair by the types
+ *  of the particles.
+ *  Must only be called if simd::isSupported(SimdLevel::avx512).
+ */
+void mixtureAVX512(const LJKernelData& data, std::size_t i,
+                   const std::size_t* neighbours, std::size_t count);
+
+}  // namespace ljkernel
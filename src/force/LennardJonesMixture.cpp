@@ -0,0 +1,43 @@
+#include "LennardJonesMixture.h"
+
+#include <cmath>
+#include <utility>
+
+#include "utils/ArrayUtils.h"
+#include "utils/Logging.h"
+
+LennardJonesMixture::LennardJonesMixture(std::vector<double> epsilons_,
+                                         std::vector<double> sigmas_)
+    : epsilons(std::move(epsilons_)),
+      sigmas(std::move(sigmas_)),
+      types((int)epsilons.size()) {
+    epsilon_24.resize((std::size_t)types * types);
+    sigma_sq.resize((std::size_t)types * types);
+    for (int i = 0; i < types; i++) {
+        for (int j = 0; j < types; j++) {
+            // Lorentz-Berthelot mixing rules
+            const double epsilon = std::sqrt(epsilons[i] * epsilons[j]);
+            const double sigma = (sigmas[i] + sigmas[j]) / 2;
+            epsilon_24[i * types + j] = epsilon * (-24);
+            sigma_sq[i * types + j] = sigma * sigma;
+        }
+    }
+}
+
+std::array<double, 3> LennardJonesMixture::calculateForce(Particle& p1,
+                                                          Particle& p2) const {
+    std::array<double, 3> diff = p1.getX() - p2.getX();
+    double distanceSq =
+        diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
+    std::array<double, 3> force =
+        calculatePairScalar(distanceSq, p1.getType(), p2.getType()) * diff;
+
+    SPDLOG_LOGGER_TRACE(logging::file(), "Calculating force LenJonesMixture: types: {} {}, dist^2: {}, force: {}", p1.getType(), p2.getType(), distanceSq, ArrayUtils::to_string(force));
+
+    return force;
+}
+
+std::string LennardJonesMixture::typeString() {
+    return "Lennard-Jones-Potential for a mixture of " +
+           std::to_string(types) + " types of molecules";
+}
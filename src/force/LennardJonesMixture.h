@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vector>
+
+#include "CentralForce.h"
+
+/** \brief
+ *  The Lennard-Jones potential between particles of different types.
+ *  Every type has its own epsilon and sigma, the parameters of a pair are
+ *  mixed with the Lorentz-Berthelot rules
+ *  epsilon_ij = sqrt(epsilon_i * epsilon_j) and
+ *  sigma_ij = (sigma_i + sigma_j) / 2.
+ *  The mixed parameters are precomputed into dense tables indexed by
+ *  type_i * types + type_j, so the force calculation only looks them up.
+ *  The types of the particles have to be in [0, types).
+ */
+class LennardJonesMixture final : public CentralForce {
+   private:
+    /** \brief
+     *  The epsilon parameter of every type
+     */
+    std::vector<double> epsilons;
+
+    /** \brief
+     *  The sigma parameter of every type
+     */
+    std::vector<double> sigmas;
+
+    /** \brief
+     *  The amount of types
+     */
+    int types;
+
+    /** \brief
+     *  The mixed epsilon parameter times -24 of every pair of types
+     */
+    std::vector<double> epsilon_24;
+
+    /** \brief
+     *  The mixed sigma parameter squared of every pair of types
+     */
+    std::vector<double> sigma_sq;
+
+   public:
+    /** \brief
+     *  Constructor for the LennardJonesMixture class
+     *
+     *  \param epsilons_
+     *  The epsilon parameter of every type
+     *
+     *  \param sigmas_
+     *  The sigma parameter of every type, has to have the same size as
+     *  epsilons_
+     */
+    LennardJonesMixture(std::vector<double> epsilons_,
+                        std::vector<double> sigmas_);
+
+    /** \brief
+     *  Destructor for the LennardJonesMixture class
+     */
+    ~LennardJonesMixture() override = default;
+
+    /** \brief
+     *  Calculates the force between two particles with the mixed parameters
+     *  of their types
+     *
+     *  \param p1
+     *  The first particle
+     *
+     *  \param p2
+     *  The second particle
+     *
+     *  \return
+     *  The force between the two particles
+     */
+    std::array<double, 3> calculateForce(Particle& p1,
+                                         Particle& p2) const override;
+
+    /** \brief
+     *  Calculates the scalar factor of the force between two particles of
+     *  type 0, as the masses do not identify the types.
+     *  The force calculation uses calculatePairScalar instead.
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \return
+     *  The scalar factor of the force
+     */
+    double calculateScalar(double distanceSq, double /*m1*/,
+                           double /*m2*/) const override {
+        return calculatePairScalar(distanceSq, 0, 0);
+    }
+
+    /** \brief
+     *  Calculates the scalar factor of the force from the squared distance
+     *  and the types of the particles, without any branch
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \param type1
+     *  The type of the first particle
+     *
+     *  \param type2
+     *  The type of the second particle
+     *
+     *  \return
+     *  The scalar factor of the force
+     */
+    double calculatePairScalar(double distanceSq, int type1, int type2) const {
+        const int pair = type1 * types + type2;
+        double summand_2 = sigma_sq[pair] / distanceSq;
+        double summand_6 = summand_2 * summand_2 * summand_2;
+        double summand_12 = summand_6 * summand_6;
+
+        return (epsilon_24[pair] / distanceSq) * (summand_6 - (2 * summand_12));
+    }
+
+    /** \brief
+     *  Returns the amount of types
+     */
+    int getTypes() const { return types; }
+
+    /** \brief
+     *  Returns the table of the mixed epsilon parameters times -24, as used by
+     *  the SIMD kernels
+     */
+    const double* getEpsilon24Table() const { return epsilon_24.data(); }
+
+    /** \brief
+     *  Returns the table of the mixed sigma parameters squared, as used by the
+     *  SIMD kernels
+     */
+    const double* getSigmaSqTable() const { return sigma_sq.data(); }
+
+    /** \brief
+     *  Returns the type of the force
+     *
+     *  \return
+     *  The type of the force
+     */
+    std::string typeString() override;
+};
@@ -1,12 +1,13 @@
 #include "LennardJonesMolecule.h"
 
 #include <cmath>
-#include <spdlog/spdlog.h>
 #include "utils/ArrayUtils.h"
+#include "utils/Logging.h"
 
 LennardJonesMolecule::LennardJonesMolecule(double epsilon_, double sigma_)
     : epsilon(epsilon_), sigma(sigma_) {
     epsilon_24 = epsilon * (-24);
+    sigma_sq = sigma * sigma;
 }
 
 std::array<double, 3> LennardJonesMolecule::calculateForce(Particle& p1,
@@ -20,9 +21,7 @@ std::array<double, 3> LennardJonesMolecule::calculateForce(Particle& p1,
                                   (summand_6 - (2 * summand_12)) *
                                   (p1.getX() - p2.getX());
 
-#ifndef NO_LOG
-    spdlog::get("file")->trace ("Calculating force LenJonesMol: s_6: {}, s_12: {}, dist: {}, force: {}", summand_6, summand_12, distance, ArrayUtils::to_string(force));
-#endif
+    SPDLOG_LOGGER_TRACE(logging::file(), "Calculating force LenJonesMol: s_6: {}, s_12: {}, dist: {}, force: {}", summand_6, summand_12, distance, ArrayUtils::to_string(force));
 
     return force;
 }
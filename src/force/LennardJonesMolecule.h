@@ -1,4 +1,6 @@
-#include "Force.h"
+#pragma once
+
+#include "CentralForce.h"
 
 /** \brief
  *  The Lennard-Jones potential is a pairwise potential that describes the
@@ -7,7 +9,7 @@
  *  The Lennard-Jones potential is a pairwise potential, so the force is only
  *  calculated between two particles.
  */
-class LennardJonesMolecule : public Force {
+class LennardJonesMolecule final : public CentralForce {
    private:
     /** \brief
      *  The epsilon parameter of the Lennard-Jones potential
@@ -20,10 +22,15 @@ class LennardJonesMolecule : public Force {
     double sigma;
 
     /** \brief
-     *  The epsilon parameter times 24
+     *  The epsilon parameter times -24
      */
     double epsilon_24;
 
+    /** \brief
+     *  The sigma parameter squared
+     */
+    double sigma_sq;
+
    public:
     /** \brief
      *  Constructor for the LennardJonesMolecule class
@@ -57,6 +64,41 @@ class LennardJonesMolecule : public Force {
     std::array<double, 3> calculateForce(Particle& p1,
                                          Particle& p2) const override;
 
+    /** \brief
+     *  Calculates the scalar factor of the Lennard-Jones force from the
+     *  squared distance, without any root or power function
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \param m1
+     *  The mass of the first particle (unused)
+     *
+     *  \param m2
+     *  The mass of the second particle (unused)
+     *
+     *  \return
+     *  The scalar factor of the force
+     */
+    double calculateScalar(double distanceSq, double /*m1*/,
+                           double /*m2*/) const override {
+        double summand_2 = sigma_sq / distanceSq;
+        double summand_6 = summand_2 * summand_2 * summand_2;
+        double summand_12 = summand_6 * summand_6;
+
+        return (epsilon_24 / distanceSq) * (summand_6 - (2 * summand_12));
+    }
+
+    /** \brief
+     *  Returns the epsilon parameter times -24, as used by the SIMD kernels
+     */
+    double getEpsilon24() const { return epsilon_24; }
+
+    /** \brief
+     *  Returns the sigma parameter squared, as used by the SIMD kernels
+     */
+    double getSigmaSq() const { return sigma_sq; }
+
     /** \brief
      *  Returns the type of the force
      *
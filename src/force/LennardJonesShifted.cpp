@@ -0,0 +1,14 @@
+#include "LennardJonesShifted.h"
+
+LennardJonesShifted::LennardJonesShifted(double epsilon, double sigma,
+                                         double cutoff)
+    : epsilon_24(epsilon * (-24)),
+      sigma_sq(sigma * sigma),
+      cutoff_sq(cutoff * cutoff) {
+    forceShift = plainScalar(cutoff_sq);
+    potentialShift = plainPotential(cutoff_sq);
+}
+
+std::string LennardJonesShifted::typeString() {
+    return "Truncated and shifted Lennard-Jones-Potential for molecules";
+}
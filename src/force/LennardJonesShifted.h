@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CentralForce.h"
+
+/** \brief
+ *  The Lennard-Jones potential truncated at the cutoff radius r_c and shifted,
+ *  so that both the potential and the force are 0 at r_c and particles
+ *  crossing the cutoff do not change the energy abruptly.
+ *  The shift is quadratic in the distance,
+ *  U(r) = V(r) - V(r_c) + s(r_c) * (r^2 - r_c^2) / 2,
+ *  where s is the scalar of the plain Lennard-Jones force. So the scalar of
+ *  the force is s(r) - s(r_c) and everything is calculated on the squared
+ *  distance, without any root or power function.
+ */
+class LennardJonesShifted final : public CentralForce {
+   private:
+    /** \brief
+     *  The epsilon parameter times -24
+     */
+    double epsilon_24;
+
+    /** \brief
+     *  The sigma parameter squared
+     */
+    double sigma_sq;
+
+    /** \brief
+     *  The squared cutoff radius
+     */
+    double cutoff_sq;
+
+    /** \brief
+     *  The scalar of the plain Lennard-Jones force at the cutoff
+     */
+    double forceShift;
+
+    /** \brief
+     *  The plain Lennard-Jones potential at the cutoff
+     */
+    double potentialShift;
+
+    /** \brief
+     *  The scalar of the plain Lennard-Jones force
+     */
+    double plainScalar(double distanceSq) const {
+        double summand_2 = sigma_sq / distanceSq;
+        double summand_6 = summand_2 * summand_2 * summand_2;
+        double summand_12 = summand_6 * summand_6;
+
+        return (epsilon_24 / distanceSq) * (summand_6 - (2 * summand_12));
+    }
+
+    /** \brief
+     *  The plain Lennard-Jones potential
+     */
+    double plainPotential(double distanceSq) const {
+        double summand_2 = sigma_sq / distanceSq;
+        double summand_6 = summand_2 * summand_2 * summand_2;
+
+        // 4 * epsilon = -epsilon_24 / 6
+        return -epsilon_24 / 6 * (summand_6 * summand_6 - summand_6);
+    }
+
+   public:
+    /** \brief
+     *  Constructor for the LennardJonesShifted class
+     *
+     *  \param epsilon
+     *  The epsilon parameter of the Lennard-Jones potential
+     *
+     *  \param sigma
+     *  The sigma parameter of the Lennard-Jones potential
+     *
+     *  \param cutoff
+     *  The cutoff radius r_c, has to be the cutoff of the container
+     */
+    LennardJonesShifted(double epsilon, double sigma, double cutoff);
+
+    /** \brief
+     *  Destructor for the LennardJonesShifted class
+     */
+    ~LennardJonesShifted() override = default;
+
+    /** \brief
+     *  Calculates the scalar factor of the shifted force from the squared
+     *  distance, 0 beyond the cutoff
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \param m1
+     *  The mass of the first particle (unused)
+     *
+     *  \param m2
+     *  The mass of the second particle (unused)
+     *
+     *  \return
+     *  The scalar factor of the force
+     */
+    double calculateScalar(double distanceSq, double /*m1*/,
+                           double /*m2*/) const override {
+        const double s = plainScalar(distanceSq) - forceShift;
+        return distanceSq <= cutoff_sq ? s : 0.;
+    }
+
+    /** \brief
+     *  Calculates the shifted potential energy of a pair, 0 beyond the cutoff
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \return
+     *  The potential energy of the pair
+     */
+    double calculatePotential(double distanceSq) const {
+        const double u = plainPotential(distanceSq) - potentialShift +
+                         forceShift * (distanceSq - cutoff_sq) / 2;
+        return distanceSq <= cutoff_sq ? u : 0.;
+    }
+
+    /** \brief
+     *  Returns the type of the force
+     *
+     *  \return
+     *  The type of the force
+     */
+    std::string typeString() override;
+};
@@ -0,0 +1,15 @@
+#include "LennardJonesSmooth.h"
+
+LennardJonesSmooth::LennardJonesSmooth(double epsilon, double sigma,
+                                       double inner, double cutoff)
+    : epsilon_24(epsilon * (-24)),
+      sigma_sq(sigma * sigma),
+      inner_sq(inner * inner),
+      cutoff_sq(cutoff * cutoff) {
+    const double width = cutoff_sq - inner_sq;
+    inverseWidth_3 = 1 / (width * width * width);
+}
+
+std::string LennardJonesSmooth::typeString() {
+    return "Smoothly switched Lennard-Jones-Potential for molecules";
+}
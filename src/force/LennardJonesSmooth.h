@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+
+#include "CentralForce.h"
+
+/** \brief
+ *  The Lennard-Jones potential smoothly switched off between the radii r_l
+ *  and r_c, so the potential and the force are continuous and vanish at the
+ *  cutoff r_c.
+ *  The potential is multiplied with the switching function
+ *  S = (r_c^2 - r^2)^2 (r_c^2 + 2 r^2 - 3 r_l^2) / (r_c^2 - r_l^2)^3,
+ *  which is 1 below r_l and 0 beyond r_c. As S is a polynomial in r^2, the
+ *  force is calculated on the squared distance without any root or power
+ *  function. Below r_l the force is the plain Lennard-Jones force.
+ */
+class LennardJonesSmooth final : public CentralForce {
+   private:
+    /** \brief
+     *  The epsilon parameter times -24
+     */
+    double epsilon_24;
+
+    /** \brief
+     *  The sigma parameter squared
+     */
+    double sigma_sq;
+
+    /** \brief
+     *  The squared radius r_l where the switching starts
+     */
+    double inner_sq;
+
+    /** \brief
+     *  The squared cutoff radius r_c
+     */
+    double cutoff_sq;
+
+    /** \brief
+     *  1 / (r_c^2 - r_l^2)^3
+     */
+    double inverseWidth_3;
+
+    /** \brief
+     *  The switching function at the squared distance clamped to
+     *  [r_l^2, r_c^2]
+     */
+    double switching(double clampedSq) const {
+        const double outer = cutoff_sq - clampedSq;
+        return outer * outer * (cutoff_sq + 2 * clampedSq - 3 * inner_sq) *
+               inverseWidth_3;
+    }
+
+   public:
+    /** \brief
+     *  Constructor for the LennardJonesSmooth class
+     *
+     *  \param epsilon
+     *  The epsilon parameter of the Lennard-Jones potential
+     *
+     *  \param sigma
+     *  The sigma parameter of the Lennard-Jones potential
+     *
+     *  \param inner
+     *  The radius r_l where the switching starts, has to be less than cutoff
+     *
+     *  \param cutoff
+     *  The cutoff radius r_c, has to be the cutoff of the container
+     */
+    LennardJonesSmooth(double epsilon, double sigma, double inner,
+                       double cutoff);
+
+    /** \brief
+     *  Destructor for the LennardJonesSmooth class
+     */
+    ~LennardJonesSmooth() override = default;
+
+    /** \brief
+     *  Calculates the scalar factor of the switched force from the squared
+     *  distance, without any branch. The clamped distance makes the
+     *  switching function 1 below r_l and 0 beyond r_c, together with its
+     *  derivative.
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \param m1
+     *  The mass of the first particle (unused)
+     *
+     *  \param m2
+     *  The mass of the second particle (unused)
+     *
+     *  \return
+     *  The scalar factor of the force
+     */
+    double calculateScalar(double distanceSq, double /*m1*/,
+                           double /*m2*/) const override {
+        double summand_2 = sigma_sq / distanceSq;
+        double summand_6 = summand_2 * summand_2 * summand_2;
+        double summand_12 = summand_6 * summand_6;
+        const double plain =
+            (epsilon_24 / distanceSq) * (summand_6 - (2 * summand_12));
+        // 4 * epsilon = -epsilon_24 / 6
+        const double potential = -epsilon_24 / 6 * (summand_12 - summand_6);
+
+        const double clamped = std::min(std::max(distanceSq, inner_sq),
+                                        cutoff_sq);
+        // -dS/dr / r = -2 dS/d(r^2)
+        const double derivative = 12 * (cutoff_sq - clamped) *
+                                  (clamped - inner_sq) * inverseWidth_3;
+        return switching(clamped) * plain + potential * derivative;
+    }
+
+    /** \brief
+     *  Calculates the switched potential energy of a pair, 0 beyond the
+     *  cutoff
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \return
+     *  The potential energy of the pair
+     */
+    double calculatePotential(double distanceSq) const {
+        double summand_2 = sigma_sq / distanceSq;
+        double summand_6 = summand_2 * summand_2 * summand_2;
+        const double clamped = std::min(std::max(distanceSq, inner_sq),
+                                        cutoff_sq);
+        return switching(clamped) * -epsilon_24 / 6 *
+               (summand_6 * summand_6 - summand_6);
+    }
+
+    /** \brief
+     *  Returns the type of the force
+     *
+     *  \return
+     *  The type of the force
+     */
+    std::string typeString() override;
+};
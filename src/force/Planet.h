@@ -1,16 +1,39 @@
 #pragma once
 
 #include <array>
+#include <cmath>
 
-#include "Force.h"
+#include "CentralForce.h"
+
+class Planet final : public CentralForce {
+   private:
+    /**
+     *  \brief
+     *  The opening angle of the Barnes-Hut approximation, 0 if all pairs are
+     *  calculated directly
+     */
+    double theta;
 
-class Planet : public Force {
    public:
     /**
      *  \brief
-     *  Default constructor
+     *  Constructor for the Planet class
+     *
+     *  \param theta_
+     *  The opening angle of the Barnes-Hut approximation. Groups of planets
+     *  whose size divided by their distance is smaller than theta act like a
+     *  single planet. 0 calculates all pairs directly.
+     */
+    explicit Planet(double theta_ = 0) : theta(theta_) {}
+
+    /**
+     *  \brief
+     *  Returns the opening angle of the Barnes-Hut approximation
+     *
+     *  \return
+     *  The opening angle, 0 if all pairs are calculated directly
      */
-    Planet() = default;
+    double getTheta() const { return theta; }
 
     /**
      *  \brief
@@ -33,6 +56,28 @@ class Planet : public Force {
     std::array<double, 3> calculateForce(Particle &p1,
                                          Particle &p2) const override;
 
+    /**
+     *  \brief
+     *  Calculates the scalar -(m1*m2)/(d^3), so that the force points from the
+     *  first planet to the second one
+     *
+     *  \param distanceSq
+     *  The squared distance between the two planets
+     *
+     *  \param m1
+     *  The mass of the first planet
+     *
+     *  \param m2
+     *  The mass of the second planet
+     *
+     *  \return
+     *  The scalar factor of the force
+     */
+    double calculateScalar(double distanceSq, double m1,
+                           double m2) const override {
+        return -(m1 * m2) / (distanceSq * std::sqrt(distanceSq));
+    }
+
     /** \brief
      *  Returns the type of the force
      *
@@ -0,0 +1,148 @@
+#include "TabulatedForce.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+TabulatedForce::TabulatedForce(const std::function<double(double)> &scalar,
+                               double inner, double cutoff,
+                               std::size_t intervals_,
+                               Interpolation interpolation_,
+                               bool scaleByMasses_)
+    : interpolation(interpolation_),
+      scaleByMasses(scaleByMasses_),
+      inner_sq(inner * inner),
+      cutoff_sq(cutoff * cutoff),
+      intervals(intervals_) {
+    if (inner <= 0 || cutoff <= inner || intervals == 0) {
+        throw std::invalid_argument(
+            "A table needs 0 < inner < cutoff and at least one interval");
+    }
+    const double spacing = (cutoff_sq - inner_sq) / intervals;
+    inverseSpacing = 1 / spacing;
+
+    // the values and the derivatives in t of the grid points, the derivatives
+    // by central differences of the sampled function. The first and last
+    // point use one-sided differences of the same order, so the function is
+    // only sampled between r_i and r_c, where it may be undefined below r_i
+    // or truncated beyond r_c.
+    const double delta = spacing / 64;
+    std::vector<double> value(intervals + 1);
+    std::vector<double> slope(intervals + 1);
+    for (std::size_t k = 0; k <= intervals; k++) {
+        const double w = inner_sq + spacing * k;
+        value[k] = scalar(w);
+        double derivative;
+        if (k == 0) {
+            derivative = (4 * scalar(w + delta) - scalar(w + 2 * delta) -
+                          3 * value[k]) /
+                         (2 * delta);
+        } else if (k == intervals) {
+            derivative = (3 * value[k] - 4 * scalar(w - delta) +
+                          scalar(w - 2 * delta)) /
+                         (2 * delta);
+        } else {
+            derivative = (scalar(w + delta) - scalar(w - delta)) / (2 * delta);
+        }
+        slope[k] = derivative * spacing;
+    }
+
+    if (interpolation == Interpolation::cubic) {
+        coefficients.resize(4 * intervals);
+        for (std::size_t k = 0; k < intervals; k++) {
+            const double f0 = value[k];
+            const double f1 = value[k + 1];
+            const double d0 = slope[k];
+            const double d1 = slope[k + 1];
+            coefficients[4 * k] = f0;
+            coefficients[4 * k + 1] = d0;
+            coefficients[4 * k + 2] = 3 * (f1 - f0) - 2 * d0 - d1;
+            coefficients[4 * k + 3] = 2 * (f0 - f1) + d0 + d1;
+        }
+    } else {
+        coefficients.resize(2 * intervals);
+        for (std::size_t k = 0; k < intervals; k++) {
+            coefficients[2 * k] = value[k];
+            coefficients[2 * k + 1] = value[k + 1] - value[k];
+        }
+    }
+}
+
+TabulatedForce::TabulatedForce(const CentralForce &force, double inner,
+                               double cutoff, std::size_t intervals_,
+                               Interpolation interpolation_,
+                               bool scaleByMasses_)
+    : TabulatedForce(
+          [&force](double distanceSq) {
+              return force.calculateScalar(distanceSq, 1, 1);
+          },
+          inner, cutoff, intervals_, interpolation_, scaleByMasses_) {}
+
+TabulatedForce TabulatedForce::fromFile(const std::string &filename,
+                                        std::size_t intervals,
+                                        Interpolation interpolation) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error(filename + " can not be read");
+    }
+
+    std::vector<double> distances;
+    std::vector<double> magnitudes;
+    std::string line;
+    for (std::size_t number = 1; std::getline(file, line); number++) {
+        const std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+
+        std::istringstream values(line);
+        double r;
+        double f;
+        std::string rest;
+        if (!(values >> r >> f) || values >> rest) {
+            throw std::runtime_error(filename + ":" + std::to_string(number) +
+                                     ": expected a distance and a force");
+        }
+        if (r <= 0 || (!distances.empty() && r <= distances.back())) {
+            throw std::runtime_error(
+                filename + ":" + std::to_string(number) +
+                ": the distances have to be positive and increasing");
+        }
+        distances.push_back(r);
+        magnitudes.push_back(f);
+    }
+    if (distances.size() < 2) {
+        throw std::runtime_error(filename +
+                                 " needs at least two distances and forces");
+    }
+
+    // linear in r between the lines of the file and extrapolated beyond them,
+    // so the derivatives at the ends are the ones of the first and last
+    // segment. The scalar is F / r.
+    auto scalar = [&](double distanceSq) {
+        const double r = std::sqrt(distanceSq);
+        const std::size_t segment =
+            std::upper_bound(distances.begin(), distances.end(), r) -
+            distances.begin();
+        const std::size_t k =
+            std::min(std::max<std::size_t>(segment, 1), distances.size() - 1) -
+            1;
+        const double t =
+            (r - distances[k]) / (distances[k + 1] - distances[k]);
+        return (magnitudes[k] + t * (magnitudes[k + 1] - magnitudes[k])) / r;
+    };
+    return {scalar, distances.front(), distances.back(), intervals,
+            interpolation};
+}
+
+double TabulatedForce::getCutoff() const { return std::sqrt(cutoff_sq); }
+
+std::string TabulatedForce::typeString() {
+    return "Tabulated force with " +
+           std::string(interpolation == Interpolation::cubic ? "cubic"
+                                                              : "linear") +
+           " interpolation";
+}
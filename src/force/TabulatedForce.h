@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "CentralForce.h"
+#include "utils/AlignedAllocator.h"
+
+/** \brief
+ *  How a TabulatedForce interpolates between its grid points
+ */
+enum class Interpolation {
+    /** \brief
+     *  Linear between two grid points, two coefficients per interval
+     */
+    linear,
+    /** \brief
+     *  Cubic Hermite spline, four coefficients per interval
+     */
+    cubic
+};
+
+/** \brief
+ *  A force sampled on a uniform grid of the squared distance between an inner
+ *  radius r_i and the cutoff r_c once, and interpolated from the table
+ *  afterwards. This replaces the root, division or power functions of an
+ *  expensive force with a lookup and a few multiply-adds.
+ *  The coefficients of every interval are stored next to each other, so one
+ *  evaluation touches a single cache line.
+ *  Below r_i the scalar is the one at r_i and beyond r_c it is 0. As the grid
+ *  is uniform in r^2, it resolves forces varying quickly at short distances
+ *  worse than the ones at long distances.
+ */
+class TabulatedForce final : public CentralForce {
+   private:
+    /** \brief
+     *  The interpolation between the grid points
+     */
+    Interpolation interpolation;
+
+    /** \brief
+     *  Whether the tabulated scalar is multiplied with the masses of both
+     *  particles
+     */
+    bool scaleByMasses;
+
+    /** \brief
+     *  The squared inner radius r_i, the first grid point
+     */
+    double inner_sq;
+
+    /** \brief
+     *  The squared cutoff radius r_c, the last grid point
+     */
+    double cutoff_sq;
+
+    /** \brief
+     *  The number of grid intervals divided by (r_c^2 - r_i^2)
+     */
+    double inverseSpacing;
+
+    /** \brief
+     *  The number of intervals between the grid points
+     */
+    std::size_t intervals;
+
+    /** \brief
+     *  The polynomial coefficients of every interval in the position t in
+     *  [0, 1] within it, two per interval if linear and four if cubic
+     */
+    AlignedVector<double> coefficients;
+
+   public:
+    /** \brief
+     *  Evaluates the table with an interpolation fixed at compile time, so
+     *  the templated force calculation can inline it without a branch
+     */
+    template <Interpolation Order>
+    struct Interpolator {
+        /** \brief
+         *  The evaluated table
+         */
+        const TabulatedForce &table;
+
+        /** \brief
+         *  Calculates the interpolated scalar factor of the force
+         */
+        double calculateScalar(double distanceSq, double m1, double m2) const {
+            return table.interpolate<Order>(distanceSq) *
+                   (table.scaleByMasses ? m1 * m2 : 1.);
+        }
+    };
+
+    /** \brief
+     *  Constructor for the TabulatedForce class sampling an arbitrary function
+     *
+     *  \param scalar
+     *  The scalar factor of the force as a function of the squared distance
+     *
+     *  \param inner
+     *  The inner radius r_i where the table starts, greater than 0
+     *
+     *  \param cutoff
+     *  The cutoff radius r_c where the table ends, greater than inner
+     *
+     *  \param intervals_
+     *  The number of intervals between the grid points
+     *
+     *  \param interpolation_
+     *  The interpolation between the grid points
+     *
+     *  \param scaleByMasses_
+     *  Whether the scalar is multiplied with the masses of both particles
+     */
+    TabulatedForce(const std::function<double(double)> &scalar, double inner,
+                   double cutoff, std::size_t intervals_,
+                   Interpolation interpolation_ = Interpolation::cubic,
+                   bool scaleByMasses_ = false);
+
+    /** \brief
+     *  Constructor for the TabulatedForce class sampling another force
+     *
+     *  \param force
+     *  The sampled force, evaluated with the masses 1
+     *
+     *  \param inner
+     *  The inner radius r_i where the table starts, greater than 0
+     *
+     *  \param cutoff
+     *  The cutoff radius r_c where the table ends, greater than inner
+     *
+     *  \param intervals_
+     *  The number of intervals between the grid points
+     *
+     *  \param interpolation_
+     *  The interpolation between the grid points
+     *
+     *  \param scaleByMasses_
+     *  Whether the scalar is multiplied with the masses of both particles,
+     *  which has to be set for forces proportional to them like Planet
+     */
+    TabulatedForce(const CentralForce &force, double inner, double cutoff,
+                   std::size_t intervals_,
+                   Interpolation interpolation_ = Interpolation::cubic,
+                   bool scaleByMasses_ = false);
+
+    /** \brief
+     *  Destructor for the TabulatedForce class
+     */
+    ~TabulatedForce() override = default;
+
+    /** \brief
+     *  Reads a force from a file of lines "r F" with increasing distances r
+     *  and the magnitude F of the force, positive if it is repulsive.
+     *  Empty lines and lines starting with # are skipped. The force is
+     *  linearly interpolated between the lines and tabulated from the first
+     *  to the last distance of the file.
+     *
+     *  \param filename
+     *  The path of the table file
+     *
+     *  \param intervals
+     *  The number of intervals between the grid points
+     *
+     *  \param interpolation
+     *  The interpolation between the grid points
+     *
+     *  \return
+     *  The tabulated force
+     *
+     *  \throws std::runtime_error
+     *  If the file can not be read or has less than two lines of increasing
+     *  positive distances
+     */
+    static TabulatedForce fromFile(const std::string &filename,
+                                   std::size_t intervals,
+                                   Interpolation interpolation);
+
+    /** \brief
+     *  Returns the interpolation between the grid points
+     *
+     *  \return
+     *  The interpolation
+     */
+    Interpolation getInterpolation() const { return interpolation; }
+
+    /** \brief
+     *  Returns the cutoff radius, the end of the table
+     *
+     *  \return
+     *  The cutoff radius r_c
+     */
+    double getCutoff() const;
+
+    /** \brief
+     *  Interpolates the tabulated scalar without the masses, without any
+     *  branch
+     *
+     *  \tparam Order
+     *  The interpolation, has to be the one of the table
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \return
+     *  The interpolated scalar, 0 beyond the cutoff
+     */
+    template <Interpolation Order>
+    double interpolate(double distanceSq) const {
+        constexpr std::size_t stride = Order == Interpolation::cubic ? 4 : 2;
+        const double x =
+            (std::min(std::max(distanceSq, inner_sq), cutoff_sq) - inner_sq) *
+            inverseSpacing;
+        // the cutoff itself belongs to the last interval
+        const std::size_t k = std::min(static_cast<std::size_t>(x),
+                                       intervals - 1);
+        const double t = x - static_cast<double>(k);
+        const double *c = coefficients.data() + stride * k;
+
+        double s;
+        if constexpr (Order == Interpolation::cubic) {
+            s = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+        } else {
+            s = c[0] + t * c[1];
+        }
+        return distanceSq <= cutoff_sq ? s : 0.;
+    }
+
+    /** \brief
+     *  Calculates the interpolated scalar factor of the force
+     *
+     *  \param distanceSq
+     *  The squared distance between the two particles
+     *
+     *  \param m1
+     *  The mass of the first particle, only used if scaled by the masses
+     *
+     *  \param m2
+     *  The mass of the second particle, only used if scaled by the masses
+     *
+     *  \return
+     *  The scalar factor of the force
+     */
+    double calculateScalar(double distanceSq, double m1,
+                           double m2) const override {
+        if (interpolation == Interpolation::cubic) {
+            return Interpolator<Interpolation::cubic>{*this}.calculateScalar(
+                distanceSq, m1, m2);
+        }
+        return Interpolator<Interpolation::linear>{*this}.calculateScalar(
+            distanceSq, m1, m2);
+    }
+
+    /** \brief
+     *  Returns the type of the force
+     *
+     *  \return
+     *  The type of the force
+     */
+    std::string typeString() override;
+};
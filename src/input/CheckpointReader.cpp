@@ -0,0 +1,105 @@
+#include "CheckpointReader.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "utils/MappedFile.h"
+
+CheckpointReader::CheckpointReader(std::string filename_)
+    : filename(std::move(filename_)) {
+    MappedFile file(filename);
+    if (file.size() < sizeof(checkpoint::Header)) {
+        throw std::runtime_error(filename + " is not a checkpoint");
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    const checkpoint::Header expected = checkpoint::makeHeader();
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(filename + " is not a checkpoint");
+    }
+    if (header.version != checkpoint::VERSION) {
+        throw std::runtime_error(filename + " has the unsupported version " +
+                                 std::to_string(header.version));
+    }
+    if (header.byteOrder != checkpoint::BYTE_ORDER_MARK) {
+        throw std::runtime_error(
+            filename + " was written on a machine with a different byte order");
+    }
+    if (file.size() != checkpoint::fileSize(header.count)) {
+        throw std::runtime_error(filename + " is truncated");
+    }
+}
+
+void CheckpointReader::readData(std::list<Particle> &list) {
+    ParticleContainer container(count());
+    readInto(container, 0);
+    for (std::size_t i = 0; i < container.size(); i++) {
+        Particle &p = list.emplace_back(
+            std::array<double, 3>{container.position(0)[i],
+                                  container.position(1)[i],
+                                  container.position(2)[i]},
+            std::array<double, 3>{container.velocity(0)[i],
+                                  container.velocity(1)[i],
+                                  container.velocity(2)[i]},
+            container.mass()[i], container.type()[i]);
+        // the particle only has setters for the sum of the forces
+        std::array<double, 3> oldForce = {container.oldForce(0)[i],
+                                          container.oldForce(1)[i],
+                                          container.oldForce(2)[i]};
+        std::array<double, 3> force = {container.force(0)[i],
+                                       container.force(1)[i],
+                                       container.force(2)[i]};
+        p.addF(oldForce);
+        p.nextIteration();
+        p.addF(force);
+    }
+}
+
+std::size_t CheckpointReader::count() { return header.count; }
+
+void CheckpointReader::readInto(ParticleContainer &container,
+                                std::size_t offset) {
+    MappedFile file(filename);
+    const std::size_t n = header.count;
+    const char *data = file.data() + sizeof(checkpoint::Header);
+
+    // the arrays are stored in the same layout as in the container
+    auto readArray = [&](void *destination, std::size_t bytes) {
+        std::memcpy(destination, data, bytes);
+        data += bytes;
+    };
+    for (int d = 0; d < 3; d++) {
+        readArray(container.position(d) + offset, n * sizeof(double));
+    }
+    for (int d = 0; d < 3; d++) {
+        readArray(container.velocity(d) + offset, n * sizeof(double));
+    }
+    for (int d = 0; d < 3; d++) {
+        readArray(container.force(d) + offset, n * sizeof(double));
+    }
+    for (int d = 0; d < 3; d++) {
+        readArray(container.oldForce(d) + offset, n * sizeof(double));
+    }
+    readArray(container.mass() + offset, n * sizeof(double));
+    readArray(container.type() + offset, n * sizeof(std::int32_t));
+}
+
+long CheckpointReader::getIteration() const { return header.iteration; }
+
+double CheckpointReader::getTime() const { return header.time; }
+
+double CheckpointReader::getDt() const { return header.dt; }
+
+void CheckpointReader::checkParameters(double cutoff, double skin) const {
+    if (cutoff != header.cutoff || skin != header.skin) {
+        throw std::runtime_error(
+            filename + " was written with cutoff " +
+            std::to_string(header.cutoff) + " and skin " +
+            std::to_string(header.skin) + ", but the simulation uses cutoff " +
+            std::to_string(cutoff) + " and skin " + std::to_string(skin));
+    }
+}
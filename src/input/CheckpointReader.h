@@ -0,0 +1,94 @@
+#pragma once
+
+#include <list>
+#include <string>
+
+#include "Initializer.h"
+#include "utils/CheckpointFormat.h"
+
+/**
+ * \brief
+ *  Restores the particles of a checkpoint written by the CheckpointWriter.
+ *
+ *  Besides the particles the checkpoint contains the iteration and time
+ *  step, so the simulation can continue where it was stopped.
+ */
+class CheckpointReader : public Initializer {
+   private:
+    /**
+     * \brief
+     *  The path of the checkpoint
+     */
+    std::string filename;
+
+    /**
+     * \brief
+     *  The header of the checkpoint, read by the constructor
+     */
+    checkpoint::Header header;
+
+   public:
+    /**
+     * \brief
+     *  Reads and checks the header of the checkpoint
+     * \param filename_
+     *  The path of the checkpoint
+     * \throws std::runtime_error
+     *  If the file can not be read, is no checkpoint, has an unsupported
+     *  version or byte order or is truncated
+     */
+    explicit CheckpointReader(std::string filename_);
+
+    ~CheckpointReader() override = default;
+
+    /**
+     * \brief
+     *  Appends the particles of the checkpoint to the list
+     */
+    void readData(std::list<Particle> &list) override;
+
+    /**
+     * \brief
+     *  Returns the amount of particles in the checkpoint
+     */
+    std::size_t count() override;
+
+    /**
+     * \brief
+     *  Copies the particles including their forces into the container
+     * \throws std::runtime_error
+     *  If the file can not be read
+     */
+    void readInto(ParticleContainer &container, std::size_t offset) override;
+
+    /**
+     * \brief
+     *  Returns the last iteration done before the checkpoint was written
+     */
+    [[nodiscard]] long getIteration() const;
+
+    /**
+     * \brief
+     *  Returns the simulation time of the checkpoint
+     */
+    [[nodiscard]] double getTime() const;
+
+    /**
+     * \brief
+     *  Returns the time step of the simulation that wrote the checkpoint
+     */
+    [[nodiscard]] double getDt() const;
+
+    /**
+     * \brief
+     *  Checks that the simulation continues with the cutoff and skin of the
+     *  simulation that wrote the checkpoint, whose forces it contains
+     * \param cutoff
+     *  The cutoff radius of the continued simulation
+     * \param skin
+     *  The skin of the Verlet lists of the continued simulation
+     * \throws std::runtime_error
+     *  If the cutoff or the skin differ from the ones in the checkpoint
+     */
+    void checkParameters(double cutoff, double skin) const;
+};
@@ -1,14 +1,14 @@
 #include "CuboidGenerator.h"
 
-#include <spdlog/spdlog.h>
-
 #include "utils/ArrayUtils.h"
+#include "utils/Logging.h"
 #include "utils/MaxwellBoltzmannDistribution.h"
 
 CuboidGenerator::CuboidGenerator(int x_, int y_, int z_, double distance,
                                  double mass_, double meanBrownMotion,
                                  std::array<double, 3> lowerLeftFrontCorner_,
-                                 std::array<double, 3> initialVelocity_)
+                                 std::array<double, 3> initialVelocity_,
+                                 std::uint32_t id_, int type_)
     : x(x_),
       y(y_),
       z(z_),
@@ -16,16 +16,19 @@ CuboidGenerator::CuboidGenerator(int x_, int y_, int z_, double distance,
       h(distance),
       meanBrownianMotion(meanBrownMotion),
       lowerLeftFrontCorner(lowerLeftFrontCorner_),
-      initialVelocity(initialVelocity_) {}
+      initialVelocity(initialVelocity_),
+      id(id_),
+      type(type_) {}
 
 void CuboidGenerator::readData(std::list<Particle> &list) {
     if (x < 1 || y < 1 || z < 1) {
-        spdlog::get("console")->error(
+        logging::console()->error(
             "At least one dimension of a Cuboid was less than 0."
             "Will ignore this cuboid.");
         return;
     }
 
+    std::uint64_t index = 0;
     for (int X = 0; X < x; X++) {
         for (int Y = 0; Y < y; Y++) {
             for (int Z = 0; Z < z; Z++) {
@@ -35,14 +38,64 @@ void CuboidGenerator::readData(std::list<Particle> &list) {
                     (h * location) + lowerLeftFrontCorner;
                 std::array<double, 3> velocity =
                     initialVelocity +
-                    maxwellBoltzmannDistributedVelocity(meanBrownianMotion, 3);
-                spdlog::get("file")->debug("Particle emplaced back with X: " + ArrayUtils::to_string(position) + " V: " + ArrayUtils::to_string(velocity) + " mass: " + std::to_string(mass));
-                list.emplace_back(position, velocity, mass);
+                    maxwellBoltzmannDistributedVelocity(meanBrownianMotion, 3,
+                                                        id, index++);
+                SPDLOG_LOGGER_DEBUG(logging::file(), "Particle emplaced back with X: {} V: {} mass: {}", ArrayUtils::to_string(position), ArrayUtils::to_string(velocity), mass);
+                list.emplace_back(position, velocity, mass, type);
             }
         }
     }
 }
 
+std::size_t CuboidGenerator::count() {
+    if (x < 1 || y < 1 || z < 1) {
+        return 0;
+    }
+    return (std::size_t)x * y * z;
+}
+
+void CuboidGenerator::readInto(ParticleContainer &container,
+                               std::size_t offset) {
+    const std::size_t n = count();
+    if (n == 0) {
+        logging::console()->error(
+            "At least one dimension of a Cuboid was less than 0."
+            "Will ignore this cuboid.");
+        return;
+    }
+
+    double* px = container.position(0) + offset;
+    double* py = container.position(1) + offset;
+    double* pz = container.position(2) + offset;
+    double* vx = container.velocity(0) + offset;
+    double* vy = container.velocity(1) + offset;
+    double* vz = container.velocity(2) + offset;
+    double* m = container.mass() + offset;
+    int* t = container.type() + offset;
+
+    // the index determines the position and the random velocity, so the
+    // result does not depend on the amount of threads. Z changes fastest
+    // like in readData.
+#pragma omp parallel for schedule(static)
+    for (std::size_t k = 0; k < n; k++) {
+        const std::size_t Z = k % z;
+        const std::size_t Y = k / z % y;
+        const std::size_t X = k / z / y;
+        px[k] = h * X + lowerLeftFrontCorner[0];
+        py[k] = h * Y + lowerLeftFrontCorner[1];
+        pz[k] = h * Z + lowerLeftFrontCorner[2];
+
+        std::array<double, 3> brownian =
+            maxwellBoltzmannDistributedVelocity(meanBrownianMotion, 3, id, k);
+        vx[k] = initialVelocity[0] + brownian[0];
+        vy[k] = initialVelocity[1] + brownian[1];
+        vz[k] = initialVelocity[2] + brownian[2];
+
+        m[k] = mass;
+        t[k] = type;
+    }
+}
+
 int CuboidGenerator::getX() const { return x; }
 
 int CuboidGenerator::getY() const { return y; }
@@ -64,3 +117,7 @@ const std::array<double, 3> &CuboidGenerator::getLLFC() const {
 const std::array<double, 3> &CuboidGenerator::getInitialVelocity() const {
     return initialVelocity;
 }
+
+std::uint32_t CuboidGenerator::getId() const { return id; }
+
+int CuboidGenerator::getType() const { return type; }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 
 #include "Initializer.h"
 
@@ -55,6 +56,19 @@ class CuboidGenerator : public Initializer {
      */
     std::array<double, 3> initialVelocity;
 
+    /**
+     * \brief
+     *  Selects the random velocities of the Brownian motion, cuboids with
+     *  different ids get independent velocities
+     */
+    std::uint32_t id;
+
+    /**
+     * \brief
+     *  The type of every particle in the cuboid
+     */
+    int type;
+
    public:
     /**
      * \brief
@@ -76,11 +90,18 @@ class CuboidGenerator : public Initializer {
      * front)
      * \param initialVelocity_ The average initial velocity of all the
      * particles in the cuboid
+     * \param id_
+     *  Selects the random velocities of the Brownian motion. Together with
+     *  the index of a particle it determines its velocity, independent of the
+     *  order of generation and the amount of threads.
+     * \param type_
+     *  The type of every particle in the cuboid
      */
     CuboidGenerator(int x_, int y_, int z_, double distance, double mass_,
                     double meanBrownMotion,
                     std::array<double, 3> lowerLeftFrontCorner_,
-                    std::array<double, 3> initialVelocity_);
+                    std::array<double, 3> initialVelocity_,
+                    std::uint32_t id_ = 0, int type_ = 0);
 
     /**
      * \brief
@@ -99,6 +120,21 @@ class CuboidGenerator : public Initializer {
      */
     void readData(std::list<Particle>& list) override;
 
+    /**
+     * \brief
+     *  Returns the amount of particles in the cuboid, 0 if a dimension is
+     *  less than 1
+     */
+    std::size_t count() override;
+
+    /**
+     * \brief
+     *  Generates the particles directly into the container, in the same
+     *  order and with the same velocities as readData. The particles are
+     *  generated in parallel.
+     */
+    void readInto(ParticleContainer& container, std::size_t offset) override;
+
     /**
      * \brief
      *  Getter for the x dimension of the cuboid
@@ -165,4 +201,16 @@ class CuboidGenerator : public Initializer {
      *  The average initial velocity of all the particles in the cuboid
      */
     [[nodiscard]] const std::array<double, 3> &getInitialVelocity() const;
+
+    /**
+     * \brief
+     *  Getter for the id selecting the random velocities
+     */
+    [[nodiscard]] std::uint32_t getId() const;
+
+    /**
+     * \brief
+     *  Getter for the type of every particle in the cuboid
+     */
+    [[nodiscard]] int getType() const;
 };
@@ -7,53 +7,206 @@
 
 #include "FileReader.h"
 
-#include <cstdlib>
-#include <fstream>
-#include <iostream>
-#include <sstream>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "utils/MappedFile.h"
 
 FileReader::FileReader(const char* filename_) : filename(filename_) {}
 
+namespace {
+/**
+ * The amount of values in a particle line: position, velocity and mass
+ */
+constexpr int VALUES = 7;
+
+/**
+ * The number of particles and where they start in the file
+ */
+struct Header {
+    std::size_t count;
+    const char* body;
+    std::size_t line;
+};
+
+[[noreturn]] void fail(const char* filename, std::size_t line,
+                       const std::string& message) {
+    throw std::runtime_error(std::string(filename) + ":" +
+                             std::to_string(line) + ": " + message);
+}
+
+/**
+ * Returns the end of the line starting at p, i.e. its newline or end
+ */
+const char* lineEnd(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', end - p);
+    return newline != nullptr ? static_cast<const char*>(newline) : end;
+}
+
+/**
+ * Returns the start of the line after the one ending at e
+ */
+const char* nextLine(const char* e, const char* end) {
+    return e == end ? end : e + 1;
+}
+
+const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * Skips the comments and parses the number of particles
+ */
+Header parseHeader(const MappedFile& file, const char* filename) {
+    const char* p = file.data();
+    const char* end = file.data() + file.size();
+
+    for (std::size_t line = 1; p < end; line++) {
+        const char* e = lineEnd(p, end);
+        if (skipSpaces(p, e) == e || *p == '#') {
+            p = nextLine(e, end);
+            continue;
+        }
+
+        long long count = 0;
+        const char* start = skipSpaces(p, e);
+        auto [ptr, ec] = std::from_chars(start, e, count);
+        if (ec != std::errc() || skipSpaces(ptr, e) != e || count < 0) {
+            fail(filename, line,
+                 "expected the number of particles, found \"" +
+                     std::string(p, e) + "\"");
+        }
+        return {(std::size_t)count, nextLine(e, end), line + 1};
+    }
+    fail(filename, 1, "the file does not contain the number of particles");
+}
+
+/**
+ * Parses the values of a particle line and its optional type, returns an
+ * error message or nullptr
+ */
+const char* parseLine(const char* p, const char* end, double* values,
+                      int& type) {
+    for (int k = 0; k < VALUES; k++) {
+        p = skipSpaces(p, end);
+        if (p == end) {
+            return "expected 7 values (position, velocity and mass)";
+        }
+        // from_chars does not accept a leading plus, operator>> did
+        if (*p == '+' && p + 1 < end && *(p + 1) != '-') {
+            p++;
+        }
+        auto [ptr, ec] = std::from_chars(p, end, values[k]);
+        if (ec == std::errc::result_out_of_range) {
+            return "number out of range";
+        }
+        if (ec != std::errc()) {
+            return "invalid number";
+        }
+        p = ptr;
+    }
+
+    type = 0;
+    p = skipSpaces(p, end);
+    if (p == end) {
+        return nullptr;
+    }
+    auto [ptr, ec] = std::from_chars(p, end, type);
+    if (ec != std::errc() || type < 0) {
+        return "invalid type, expected a non-negative integer";
+    }
+    if (skipSpaces(ptr, end) != end) {
+        return "unexpected characters after the type";
+    }
+    return nullptr;
+}
+}  // namespace
+
 void FileReader::readData(std::list<Particle>& particles) {
-    std::array<double, 3> x{};
-    std::array<double, 3> v{};
-    double m;
-    int num_particles = 0;
+    ParticleContainer container(count());
+    readInto(container, 0);
+    for (std::size_t i = 0; i < container.size(); i++) {
+        particles.emplace_back(
+            std::array<double, 3>{container.position(0)[i],
+                                  container.position(1)[i],
+                                  container.position(2)[i]},
+            std::array<double, 3>{container.velocity(0)[i],
+                                  container.velocity(1)[i],
+                                  container.velocity(2)[i]},
+            container.mass()[i], container.type()[i]);
+    }
+}
+
+std::size_t FileReader::count() {
+    MappedFile file(filename);
+    return parseHeader(file, filename).count;
+}
 
-    std::ifstream input_file(filename);
-    std::string tmp_string;
+void FileReader::readInto(ParticleContainer& container, std::size_t offset) {
+    MappedFile file(filename);
+    const Header header = parseHeader(file, filename);
+    const char* end = file.data() + file.size();
 
-    if (input_file.is_open()) {
-        getline(input_file, tmp_string);
-        while (tmp_string.empty() or tmp_string[0] == '#') {
-            getline(input_file, tmp_string);
+    // the line boundaries are found sequentially, so the lines can be parsed
+    // in parallel
+    std::vector<const char*> starts(header.count);
+    const char* p = header.body;
+    for (std::size_t i = 0; i < header.count; i++) {
+        if (p >= end) {
+            fail(filename, header.line + i,
+                 "expected " + std::to_string(header.count) +
+                     " particles, but the file ends after " +
+                     std::to_string(i));
         }
+        starts[i] = p;
+        p = nextLine(lineEnd(p, end), end);
+    }
 
-        std::istringstream numstream(tmp_string);
-        numstream >> num_particles;
-        getline(input_file, tmp_string);
-        for (int i = 0; i < num_particles; i++) {
-            std::istringstream datastream(tmp_string);
+    double* px = container.position(0) + offset;
+    double* py = container.position(1) + offset;
+    double* pz = container.position(2) + offset;
+    double* vx = container.velocity(0) + offset;
+    double* vy = container.velocity(1) + offset;
+    double* vz = container.velocity(2) + offset;
+    double* m = container.mass() + offset;
+    int* t = container.type() + offset;
 
-            for (auto& xj : x) {
-                datastream >> xj;
-            }
-            for (auto& vj : v) {
-                datastream >> vj;
-            }
-            if (datastream.eof()) {
-                std::cerr << "Error reading file: eof reached unexpectedly "
-                             "reading from line "
-                          << i << std::endl;
-                exit(-1);
-            }
-            datastream >> m;
-            particles.emplace_back(x, v, m);
+    // the first invalid line is reported
+    std::size_t errorIndex = header.count;
+    const char* errorMessage = nullptr;
 
-            getline(input_file, tmp_string);
+#pragma omp parallel for schedule(static)
+    for (std::size_t i = 0; i < header.count; i++) {
+        double values[VALUES];
+        int type = 0;
+        const char* message =
+            parseLine(starts[i], lineEnd(starts[i], end), values, type);
+        if (message != nullptr) {
+#pragma omp critical(fileReaderError)
+            if (i < errorIndex) {
+                errorIndex = i;
+                errorMessage = message;
+            }
+            continue;
         }
-    } else {
-        std::cerr << "Error: could not open file " << filename << std::endl;
-        exit(-1);
+        px[i] = values[0];
+        py[i] = values[1];
+        pz[i] = values[2];
+        vx[i] = values[3];
+        vy[i] = values[4];
+        vz[i] = values[5];
+        m[i] = values[6];
+        t[i] = type;
+    }
+
+    if (errorMessage != nullptr) {
+        fail(filename, header.line + errorIndex, errorMessage);
     }
 }
@@ -14,14 +14,19 @@
 /** \brief
  *  Reads the initial data from a file
  *
+ *  The file is mapped into memory and the particles are parsed in parallel
+ *  with std::from_chars.
+ *
  *  The file format is as follows:
+ *  - Empty lines and lines starting with # are skipped at the beginning
  *  - The first line contains the number of particles
  *  - The following lines contain the position, velocity and mass of each
  * particle
  *  - The lines are formatted as follows:
- *    x1 x2 x3 v1 v2 v3 m
+ *    x1 x2 x3 v1 v2 v3 m [t]
  *    where x1, x2, x3 are the position coordinates, v1, v2, v3 are the
  * velocity coordinates and m is the mass of the particle
+ *  - The type t of the particle is optional and defaults to 0
  */
 class FileReader : public Initializer {
    private:
@@ -47,6 +52,28 @@ class FileReader : public Initializer {
      *
      *  \param particles
      *  The list to store the particles in
+     *  \throws std::runtime_error
+     *  If the file can not be read or parsed, the message contains the line
      */
     void readData(std::list<Particle>& particles) override;
+
+    /** \brief
+     *  Reads the number of particles from the first line of the file
+     *
+     *  \throws std::runtime_error
+     *  If the file can not be read or has no valid number of particles
+     */
+    std::size_t count() override;
+
+    /** \brief
+     *  Reads the data from the file directly into the container
+     *
+     *  \param container
+     *  The container to store the particles in
+     *  \param offset
+     *  The index of the first particle of the file in the container
+     *  \throws std::runtime_error
+     *  If the file can not be read or parsed, the message contains the line
+     */
+    void readInto(ParticleContainer& container, std::size_t offset) override;
 };
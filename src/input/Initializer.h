@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <list>
 
 #include "container/Particle.h"
+#include "container/ParticleContainer.h"
 
 /**
  * Interface for the input of data
@@ -12,4 +14,22 @@ class Initializer {
     Initializer() = default;
     virtual ~Initializer() = default;
     virtual void readData(std::list<Particle>& list) = 0;
-};
\ No newline at end of file
+
+    /**
+     * \brief
+     *  Returns the amount of particles readInto creates, so the container
+     *  can be allocated before any particle is read
+     */
+    virtual std::size_t count() = 0;
+
+    /**
+     * \brief
+     *  Writes the particles directly into the arrays of the container
+     * \param container
+     *  The container to fill. Has to hold at least offset + count()
+     *  particles.
+     * \param offset
+     *  The index of the first particle to write
+     */
+    virtual void readInto(ParticleContainer& container, std::size_t offset) = 0;
+};
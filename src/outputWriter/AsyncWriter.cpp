@@ -0,0 +1,97 @@
+#include "outputWriter/AsyncWriter.h"
+
+#include <utility>
+
+namespace outputWriter {
+
+AsyncWriter::AsyncWriter(std::shared_ptr<Writer> writer_, std::size_t depth)
+    : writer(std::move(writer_)), buffers(depth == 0 ? 1 : depth) {
+    for (std::size_t b = buffers.size(); b > 0; b--) {
+        freeBuffers.push_back(b - 1);
+    }
+    worker = std::thread(&AsyncWriter::run, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobQueued.notify_one();
+    worker.join();
+}
+
+void AsyncWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        jobQueued.wait(lock, [this] { return !pending.empty() || stopping; });
+        if (pending.empty()) {
+            return;
+        }
+
+        Job job = std::move(pending.front());
+        pending.pop_front();
+        writing = true;
+
+        // the buffer belongs to this thread until it is freed again
+        lock.unlock();
+        try {
+            writer->plotParticles(buffers[job.buffer], job.filename,
+                                  job.iteration);
+        } catch (...) {
+            lock.lock();
+            if (!error) {
+                error = std::current_exception();
+            }
+            lock.unlock();
+        }
+        lock.lock();
+
+        writing = false;
+        freeBuffers.push_back(job.buffer);
+        jobDone.notify_all();
+    }
+}
+
+void AsyncWriter::rethrowError() {
+    if (error) {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+void AsyncWriter::plotParticles(ParticleContainer& container,
+                                const std::string& filename, int iteration) {
+    std::size_t buffer;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        rethrowError();
+        // back-pressure: wait until the oldest output has been written
+        jobDone.wait(lock, [this] { return !freeBuffers.empty(); });
+        buffer = freeBuffers.back();
+        freeBuffers.pop_back();
+    }
+
+    // the buffer is neither queued nor written, so no lock is needed
+    buffers[buffer].copyParticles(container);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back({buffer, filename, iteration});
+    }
+    jobQueued.notify_one();
+}
+
+void AsyncWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [this] { return pending.empty() && !writing; });
+    rethrowError();
+    writer->flush();
+}
+
+std::string AsyncWriter::typeString() {
+    return "AsyncWriter(" + writer->typeString() + ")";
+}
+
+}  // namespace outputWriter
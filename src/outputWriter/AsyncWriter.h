@@ -0,0 +1,159 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "outputWriter/Writer.h"
+
+namespace outputWriter {
+
+/**
+ * \brief
+ *  Decorates a Writer, so the output is written by a background thread while
+ *  the simulation continues.
+ *
+ *  plotParticles only copies the particles into a snapshot buffer and queues
+ *  it. The buffers are reused, so no memory is allocated after the first
+ *  outputs. If all buffers are queued because the disk can not keep up,
+ *  plotParticles waits until the oldest one has been written.
+ */
+class AsyncWriter : public Writer {
+   private:
+    /**
+     * \brief
+     *  A queued output
+     */
+    struct Job {
+        std::size_t buffer;
+        std::string filename;
+        int iteration;
+    };
+
+    /**
+     * \brief
+     *  The writer doing the actual output in the background thread
+     */
+    std::shared_ptr<Writer> writer;
+
+    /**
+     * \brief
+     *  The snapshot buffers, one per possibly queued output
+     */
+    std::vector<ParticleContainer> buffers;
+
+    /**
+     * \brief
+     *  The buffers that are neither queued nor being written
+     */
+    std::vector<std::size_t> freeBuffers;
+
+    /**
+     * \brief
+     *  The outputs waiting for the background thread, oldest first
+     */
+    std::deque<Job> pending;
+
+    /**
+     * \brief
+     *  True while the background thread writes an output
+     */
+    bool writing = false;
+
+    /**
+     * \brief
+     *  Set to stop the background thread once the queue is empty
+     */
+    bool stopping = false;
+
+    /**
+     * \brief
+     *  The first exception thrown by the writer, rethrown by the simulation
+     *  thread
+     */
+    std::exception_ptr error;
+
+    /**
+     * \brief
+     *  Protects all members above except writer and the buffer contents
+     */
+    std::mutex mutex;
+
+    /**
+     * \brief
+     *  Notified when an output was queued or the thread shall stop
+     */
+    std::condition_variable jobQueued;
+
+    /**
+     * \brief
+     *  Notified when an output has been written
+     */
+    std::condition_variable jobDone;
+
+    /**
+     * \brief
+     *  The background thread, started last
+     */
+    std::thread worker;
+
+    /**
+     * \brief
+     *  The loop of the background thread
+     */
+    void run();
+
+    /**
+     * \brief
+     *  Rethrows the exception of the writer, if there was one.
+     *  The mutex has to be held.
+     */
+    void rethrowError();
+
+   public:
+    /**
+     * \brief
+     *  Creates the writer and starts the background thread
+     * \param writer_
+     *  The writer doing the actual output
+     * \param depth
+     *  The amount of snapshot buffers, i.e. how many outputs can be queued
+     *  before the simulation has to wait. Has to be at least 1.
+     */
+    AsyncWriter(std::shared_ptr<Writer> writer_, std::size_t depth = 2);
+
+    /**
+     * \brief
+     *  Writes all queued outputs and stops the background thread
+     */
+    ~AsyncWriter() override;
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    /**
+     * \brief
+     *  Copies the particles and queues them to be written by the background
+     *  thread. Blocks if all snapshot buffers are queued.
+     *  Rethrows exceptions of earlier outputs.
+     */
+    void plotParticles(ParticleContainer& container,
+                       const std::string& filename, int iteration) override;
+
+    /**
+     * \brief
+     *  Blocks until all queued outputs have been written.
+     *  Rethrows exceptions of the outputs.
+     */
+    void flush() override;
+
+    std::string typeString() override;
+};
+
+}  // namespace outputWriter
@@ -0,0 +1,72 @@
+#include "outputWriter/CheckpointWriter.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "utils/CheckpointFormat.h"
+
+static_assert(sizeof(int) == sizeof(std::int32_t),
+              "the types are stored as int32");
+
+namespace outputWriter {
+
+CheckpointWriter::CheckpointWriter(double dt_, double cutoff_, double skin_)
+    : dt(dt_), cutoff(cutoff_), skin(skin_) {}
+
+void CheckpointWriter::plotParticles(ParticleContainer &particles,
+                                     const std::string &filename,
+                                     int iteration) {
+    const std::size_t n = particles.size();
+
+    checkpoint::Header header = checkpoint::makeHeader();
+    header.count = n;
+    header.iteration = iteration;
+    header.time = (iteration + 1) * dt;
+    header.dt = dt;
+    header.cutoff = cutoff;
+    header.skin = skin;
+
+    const std::string path = filename + ".checkpoint";
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        // the arrays are written as they are, without any conversion
+        auto writeArray = [&](const void *data, std::size_t bytes) {
+            file.write(static_cast<const char *>(data),
+                       (std::streamsize)bytes);
+        };
+        for (int d = 0; d < 3; d++) {
+            writeArray(particles.position(d), n * sizeof(double));
+        }
+        for (int d = 0; d < 3; d++) {
+            writeArray(particles.velocity(d), n * sizeof(double));
+        }
+        for (int d = 0; d < 3; d++) {
+            writeArray(particles.force(d), n * sizeof(double));
+        }
+        for (int d = 0; d < 3; d++) {
+            writeArray(particles.oldForce(d), n * sizeof(double));
+        }
+        writeArray(particles.mass(), n * sizeof(double));
+        writeArray(particles.type(), n * sizeof(std::int32_t));
+
+        file.close();
+        if (!file) {
+            throw std::runtime_error("could not write the checkpoint " +
+                                     temporary);
+        }
+    }
+
+    // replaces the old checkpoint atomically
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("could not replace the checkpoint " + path);
+    }
+}
+
+std::string CheckpointWriter::typeString() { return "CheckpointWriter"; }
+
+}  // namespace outputWriter
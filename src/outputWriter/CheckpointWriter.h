@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+
+#include "outputWriter/Writer.h"
+
+namespace outputWriter {
+
+/**
+ * \brief
+ *  Writes the complete state of the particles into a binary checkpoint,
+ *  from which a simulation can be restarted with the CheckpointReader.
+ *
+ *  Every call overwrites the checkpoint filename.checkpoint. The new
+ *  checkpoint is written into a temporary file first and then renamed, so
+ *  the last complete checkpoint survives if the simulation is killed while
+ *  writing. Wrap it into an AsyncWriter to write it in the background.
+ */
+class CheckpointWriter : public Writer {
+   private:
+    /**
+     * \brief
+     *  The time step of the simulation, stored in the checkpoint
+     */
+    double dt;
+
+    /**
+     * \brief
+     *  The cutoff radius and the skin of the simulation, stored in the
+     *  checkpoint. Not taken from the particles, as the copies of an
+     *  AsyncWriter do not have them.
+     */
+    double cutoff, skin;
+
+   public:
+    /**
+     * \brief
+     *  Creates a new writer
+     * \param dt_
+     *  The time step of the simulation
+     * \param cutoff_
+     *  The cutoff radius of the simulation
+     * \param skin_
+     *  The skin of the Verlet lists of the simulation
+     */
+    explicit CheckpointWriter(double dt_, double cutoff_ = 0,
+                              double skin_ = 0);
+
+    ~CheckpointWriter() override = default;
+
+    /**
+     * \brief
+     *  Writes the checkpoint
+     * \param particles
+     *  The particles after the iteration
+     * \param filename
+     *  The prefix of the checkpoint file
+     * \param iteration
+     *  The iteration that has just been completed
+     * \throws std::runtime_error
+     *  If the checkpoint can not be written
+     */
+    void plotParticles(ParticleContainer &particles,
+                       const std::string &filename, int iteration) override;
+
+    std::string typeString() override;
+};
+
+}  // namespace outputWriter
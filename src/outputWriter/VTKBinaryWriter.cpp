@@ -0,0 +1,241 @@
+#include "outputWriter/VTKBinaryWriter.h"
+
+#ifndef NO_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace outputWriter {
+
+namespace {
+/**
+ * The size of the blocks the data is compressed in, as used by VTK
+ */
+constexpr std::size_t COMPRESSION_BLOCK = 1 << 15;
+
+const char BASE64_CHARS[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**
+ * Appends the base64 encoding of the bytes to out
+ */
+void encodeBase64(const unsigned char *bytes, std::size_t count,
+                  std::string &out) {
+    out.reserve(out.size() + (count + 2) / 3 * 4);
+    std::size_t i = 0;
+    for (; i + 3 <= count; i += 3) {
+        std::uint32_t triple = (bytes[i] << 16) | (bytes[i + 1] << 8) |
+                               bytes[i + 2];
+        out += BASE64_CHARS[(triple >> 18) & 63];
+        out += BASE64_CHARS[(triple >> 12) & 63];
+        out += BASE64_CHARS[(triple >> 6) & 63];
+        out += BASE64_CHARS[triple & 63];
+    }
+    if (i < count) {
+        std::uint32_t triple = bytes[i] << 16;
+        if (i + 1 < count) {
+            triple |= bytes[i + 1] << 8;
+        }
+        out += BASE64_CHARS[(triple >> 18) & 63];
+        out += BASE64_CHARS[(triple >> 12) & 63];
+        out += i + 1 < count ? BASE64_CHARS[(triple >> 6) & 63] : '=';
+        out += '=';
+    }
+}
+
+/**
+ * Returns the byte order of the executing machine as named by VTK
+ */
+const char *byteOrder() {
+    const std::uint16_t one = 1;
+    unsigned char first;
+    std::memcpy(&first, &one, 1);
+    return first == 1 ? "LittleEndian" : "BigEndian";
+}
+
+/**
+ * Writes the XML element of an appended data array
+ */
+void writeDataArray(std::ostream &file, const char *type, const char *name,
+                    int components, std::size_t offset) {
+    file << "        <DataArray type=\"" << type << "\" Name=\"" << name
+         << "\" NumberOfComponents=\"" << components
+         << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+}
+}  // namespace
+
+VTKBinaryWriter::VTKBinaryWriter(Encoding encoding_, bool compress_)
+    : encoding(encoding_), compress(compress_) {
+    if (compress && !compressionAvailable()) {
+        throw std::invalid_argument(
+            "MolSim was built without zlib, compression is not available");
+    }
+}
+
+bool VTKBinaryWriter::compressionAvailable() {
+#ifdef NO_ZLIB
+    return false;
+#else
+    return true;
+#endif
+}
+
+void VTKBinaryWriter::appendEncoded(const void *data, std::size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    if (encoding == Encoding::base64) {
+        encodeBase64(static_cast<const unsigned char *>(data), bytes,
+                     appended);
+    } else {
+        appended.append(static_cast<const char *>(data), bytes);
+    }
+}
+
+std::size_t VTKBinaryWriter::appendArray(const void *data, std::size_t bytes) {
+    const std::size_t offset = appended.size();
+
+    if (!compress) {
+        // the header is encoded separately from the data
+        const std::uint64_t header = bytes;
+        appendEncoded(&header, sizeof(header));
+        appendEncoded(data, bytes);
+        return offset;
+    }
+
+#ifndef NO_ZLIB
+    // header: amount of blocks, block size, size of the last partial block
+    // (0 if it is full), compressed size of every block
+    const std::size_t blocks =
+        (bytes + COMPRESSION_BLOCK - 1) / COMPRESSION_BLOCK;
+    std::vector<std::uint64_t> header = {blocks, COMPRESSION_BLOCK,
+                                         bytes % COMPRESSION_BLOCK};
+
+    compressed.clear();
+    const auto *source = static_cast<const unsigned char *>(data);
+    for (std::size_t b = 0; b < blocks; b++) {
+        const std::size_t blockSize =
+            std::min(COMPRESSION_BLOCK, bytes - b * COMPRESSION_BLOCK);
+        uLongf compressedSize = compressBound(blockSize);
+        const std::size_t start = compressed.size();
+        compressed.resize(start + compressedSize);
+
+        // the output is written often, so speed is preferred over size
+        if (compress2(compressed.data() + start, &compressedSize,
+                      source + b * COMPRESSION_BLOCK, blockSize,
+                      Z_BEST_SPEED) != Z_OK) {
+            throw std::runtime_error("zlib could not compress the output");
+        }
+        compressed.resize(start + compressedSize);
+        header.push_back(compressedSize);
+    }
+
+    appendEncoded(header.data(), header.size() * sizeof(std::uint64_t));
+    appendEncoded(compressed.data(), compressed.size());
+#endif
+    return offset;
+}
+
+void VTKBinaryWriter::plotParticles(ParticleContainer &particles,
+                                    const std::string &filename,
+                                    int iteration) {
+    const std::size_t n = particles.size();
+    appended.clear();
+
+    // mass
+    floats.assign(particles.mass(), particles.mass() + n);
+    const std::size_t massOffset =
+        appendArray(floats.data(), floats.size() * sizeof(float));
+
+    // vectors are stored interleaved
+    auto appendVector = [&](const double *x, const double *y,
+                            const double *z) {
+        floats.resize(3 * n);
+        for (std::size_t i = 0; i < n; i++) {
+            floats[3 * i] = (float)x[i];
+            floats[3 * i + 1] = (float)y[i];
+            floats[3 * i + 2] = (float)z[i];
+        }
+        return appendArray(floats.data(), floats.size() * sizeof(float));
+    };
+
+    const std::size_t velocityOffset = appendVector(
+        particles.velocity(0), particles.velocity(1), particles.velocity(2));
+    // same as the VTKWriter
+    const std::size_t forceOffset = appendVector(
+        particles.oldForce(0), particles.oldForce(1), particles.oldForce(2));
+
+    ints.assign(particles.type(), particles.type() + n);
+    const std::size_t typeOffset =
+        appendArray(ints.data(), ints.size() * sizeof(std::int32_t));
+
+    const std::size_t pointsOffset = appendVector(
+        particles.position(0), particles.position(1), particles.position(2));
+
+    // there are no cells, but ParaView expects the arrays
+    const std::size_t emptyOffset = appendArray(nullptr, 0);
+
+    std::stringstream strstr;
+    strstr << filename << "_" << std::setfill('0') << std::setw(4) << iteration
+           << ".vtu";
+    std::ofstream file(strstr.str(), std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("could not open " + strstr.str());
+    }
+
+    file << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+         << byteOrder() << "\" header_type=\"UInt64\"";
+    if (compress) {
+        file << " compressor=\"vtkZLibDataCompressor\"";
+    }
+    file << ">\n"
+         << "  <UnstructuredGrid>\n"
+         << "    <Piece NumberOfPoints=\"" << n << "\" NumberOfCells=\"0\">\n"
+         << "      <PointData>\n";
+    writeDataArray(file, "Float32", "mass", 1, massOffset);
+    writeDataArray(file, "Float32", "velocity", 3, velocityOffset);
+    writeDataArray(file, "Float32", "force", 3, forceOffset);
+    writeDataArray(file, "Int32", "type", 1, typeOffset);
+    file << "      </PointData>\n"
+         << "      <CellData>\n"
+         << "      </CellData>\n"
+         << "      <Points>\n";
+    writeDataArray(file, "Float32", "points", 3, pointsOffset);
+    file << "      </Points>\n"
+         << "      <Cells>\n";
+    writeDataArray(file, "Int32", "connectivity", 1, emptyOffset);
+    writeDataArray(file, "Int32", "offsets", 1, emptyOffset);
+    writeDataArray(file, "UInt8", "types", 1, emptyOffset);
+    file << "      </Cells>\n"
+         << "    </Piece>\n"
+         << "  </UnstructuredGrid>\n"
+         << "  <AppendedData encoding=\""
+         << (encoding == Encoding::base64 ? "base64" : "raw") << "\">\n"
+         << "   _";
+    file.write(appended.data(), (std::streamsize)appended.size());
+    file << "\n  </AppendedData>\n"
+         << "</VTKFile>\n";
+
+    file.close();
+    if (!file) {
+        throw std::runtime_error("could not write " + strstr.str());
+    }
+}
+
+std::string VTKBinaryWriter::typeString() {
+    std::string type = "VTKBinaryWriter(";
+    type += encoding == Encoding::base64 ? "base64" : "raw";
+    if (compress) {
+        type += ", zlib";
+    }
+    return type + ")";
+}
+
+}  // namespace outputWriter
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "outputWriter/Writer.h"
+
+namespace outputWriter {
+
+/**
+ * \brief
+ *  Writes vtk unstructured grid files (.vtu) with the particle data in
+ *  binary form in the appended data section.
+ *
+ *  The file is streamed directly from the particle arrays, there is no
+ *  intermediate XML tree. The output contains the same arrays as the
+ *  VTKWriter and can be opened with ParaView.
+ */
+class VTKBinaryWriter : public Writer {
+   public:
+    /**
+     * \brief
+     *  How the binary data is stored in the file
+     */
+    enum class Encoding {
+        /** The bytes as they are, the smallest and fastest option */
+        raw,
+        /** Base64 encoded, the file stays valid XML */
+        base64
+    };
+
+    /**
+     * \brief
+     *  Creates a new writer
+     * \param encoding_
+     *  How the binary data is stored in the file
+     * \param compress_
+     *  Compresses the data with zlib, only available if MolSim was built
+     *  with zlib
+     */
+    explicit VTKBinaryWriter(Encoding encoding_ = Encoding::raw,
+                             bool compress_ = false);
+
+    ~VTKBinaryWriter() override = default;
+
+    /**
+     * \brief
+     *  Writes the particles to <filename>_<iteration>.vtu
+     * \throws std::runtime_error
+     *  If the file can not be written
+     */
+    void plotParticles(ParticleContainer &particles,
+                       const std::string &filename, int iteration) override;
+
+    std::string typeString() override;
+
+    /**
+     * \brief
+     *  Checks if this build supports compressed output
+     */
+    static bool compressionAvailable();
+
+   private:
+    /**
+     * \brief
+     *  How the binary data is stored in the file
+     */
+    Encoding encoding;
+
+    /**
+     * \brief
+     *  Compress the data with zlib
+     */
+    bool compress;
+
+    /**
+     * \brief
+     *  The content of the appended data section, reused between files
+     */
+    std::string appended;
+
+    /**
+     * \brief
+     *  Scratch buffers for the converted arrays, reused between files
+     */
+    std::vector<float> floats;
+    std::vector<std::int32_t> ints;
+    std::vector<unsigned char> compressed;
+
+    /**
+     * \brief
+     *  Appends one data array with its header to the appended data section
+     * \param data
+     *  The data of the array
+     * \param bytes
+     *  The size of the data in bytes
+     * \return
+     *  The offset of the array in the appended data section
+     */
+    std::size_t appendArray(const void *data, std::size_t bytes);
+
+    /**
+     * \brief
+     *  Appends bytes to the appended data section in the chosen encoding
+     */
+    void appendEncoded(const void *data, std::size_t bytes);
+};
+
+}  // namespace outputWriter
@@ -61,7 +61,7 @@ void VTKWriter::writeFile(const std::string &filename, int iteration) {
     delete vtkFile;
 }
 
-void VTKWriter::plotParticle(const Particle &p) {
+void VTKWriter::plotParticle(const ParticleRef &p) {
     if (!vtkFile->UnstructuredGrid().present()) {
         std::cout << "ERROR: No UnstructuredGrid present" << std::endl;
     }
@@ -99,7 +99,7 @@ void VTKWriter::plotParticle(const Particle &p) {
 void VTKWriter::plotParticles(ParticleContainer &particles,
                               const std::string &filename, int iteration) {
     initializeOutput(particles.size());
-    for (auto &p : particles) {
+    for (auto p : particles) {
         plotParticle(p);
     }
     writeFile(filename, iteration);
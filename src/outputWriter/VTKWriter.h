@@ -34,7 +34,7 @@ class VTKWriter : public Writer {
      *
      * @note: initializeOutput() must have been called before.
      */
-    void plotParticle(const Particle &particle);
+    void plotParticle(const ParticleRef &particle);
 
     /**
      * writes the final output file.
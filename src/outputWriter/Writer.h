@@ -11,4 +11,11 @@ class Writer {
     virtual void plotParticles(ParticleContainer &container,
                                const std::string &filename, int iteration) = 0;
     virtual std::string typeString() = 0;
+
+    /**
+     * \brief
+     *  Blocks until all requested output has been written.
+     *  Writers that write synchronously do not need to override this.
+     */
+    virtual void flush() {}
 };
@@ -30,7 +30,7 @@ void XYZWriter::plotParticles(ParticleContainer &particles,
             "file format doku."
          << std::endl;
 
-    for (auto &p : particles) {
+    for (auto p : particles) {
         std::array<double, 3> x = p.getX();
         file << "Ar ";
         file.setf(std::ios_base::showpoint);
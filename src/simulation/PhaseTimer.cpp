@@ -0,0 +1,45 @@
+#include "simulation/PhaseTimer.h"
+
+#include <spdlog/fmt/fmt.h>
+
+namespace {
+const char* const PHASE_NAMES[] = {"position update", "force calculation",
+                                   "velocity update", "output",
+                                   "reorder"};
+}
+
+void PhaseTimer::reset() {
+    phases.fill(Clock::duration::zero());
+    start = Clock::now();
+}
+
+double PhaseTimer::seconds(Phase phase) const {
+    return std::chrono::duration<double>(phases[phase]).count();
+}
+
+double PhaseTimer::totalSeconds() const {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+std::string PhaseTimer::summary(int iterations, std::size_t particles) const {
+    const double total = totalSeconds();
+    // avoids dividing by 0 if the run was too short to measure
+    const double divisor = total > 0 ? total : 1;
+
+    std::string result = fmt::format(
+        "Timing of {} iterations with {} particles:\n"
+        "    total: {:.3f} s, {:.3f} MUPS\n",
+        iterations, particles, total,
+        (double)iterations * particles / divisor * 1e-6);
+
+    double other = total;
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        const double s = seconds((Phase)p);
+        other -= s;
+        result += fmt::format("    {}: {:.3f} s ({:.1f} %)\n", PHASE_NAMES[p],
+                              s, 100 * s / divisor);
+    }
+    result += fmt::format("    other: {:.3f} s ({:.1f} %)", other,
+                          100 * other / divisor);
+    return result;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * \brief
+ *  Measures how much time the simulation spends in each phase of an
+ *  iteration.
+ *
+ *  Use the TIME_PHASE macro to time a scope. If NO_TIMING is defined the macro
+ *  is empty, so the simulation does not contain any timing code.
+ */
+class PhaseTimer {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * \brief
+     *  The phases of an iteration
+     */
+    enum Phase { position, force, velocity, output, reorder, PHASE_COUNT };
+
+    /**
+     * \brief
+     *  Times one phase from its construction until the end of the scope
+     */
+    class Scope {
+       private:
+        PhaseTimer& timer;
+        Phase phase;
+        Clock::time_point begin;
+
+       public:
+        Scope(PhaseTimer& timer_, Phase phase_)
+            : timer(timer_), phase(phase_), begin(Clock::now()) {}
+
+        ~Scope() { timer.phases[phase] += Clock::now() - begin; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * \brief
+     *  Clears all phases and starts measuring the total time
+     */
+    void reset();
+
+    /**
+     * \brief
+     *  The time spent in the phase so far in seconds
+     */
+    [[nodiscard]] double seconds(Phase phase) const;
+
+    /**
+     * \brief
+     *  The time since the last reset in seconds
+     */
+    [[nodiscard]] double totalSeconds() const;
+
+    /**
+     * \brief
+     *  Summarizes the measured times
+     * \param iterations
+     *  The amount of iterations done since the last reset
+     * \param particles
+     *  The amount of particles updated in every iteration
+     * \return
+     *  The total time, the time and share of every phase and the throughput
+     *  in million particle updates per second (MUPS)
+     */
+    [[nodiscard]] std::string summary(int iterations,
+                                      std::size_t particles) const;
+
+   private:
+    /**
+     * \brief
+     *  The accumulated time of every phase
+     */
+    std::array<Clock::duration, PHASE_COUNT> phases{};
+
+    /**
+     * \brief
+     *  The time of the last reset
+     */
+    Clock::time_point start = Clock::now();
+};
+
+#ifdef NO_TIMING
+#define TIME_PHASE(timer, phase)
+#else
+/**
+ * \brief
+ *  Adds the time until the end of the enclosing scope to the phase
+ */
+#define TIME_PHASE(timer, phase) \
+    PhaseTimer::Scope phaseScope((timer), PhaseTimer::phase)
+#endif
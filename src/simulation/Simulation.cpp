@@ -2,30 +2,217 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <utility>
 
 #include "force/Force.h"
 #include "simulation/StoermerVerlet.h"
+#include "utils/Logging.h"
 
-Simulation::Simulation(ParticleContainer& container_,
+Simulation::Simulation(ParticleContainer container_,
                        std::shared_ptr<Force> method_,
                        std::shared_ptr<Writer> writer_, double dt_,
-                       int outputFrequency_, std::string filename_)
-    : container(container_),
-      method(std::move(method_)),
+                       int outputFrequency_, std::string filename_,
+                       SimdLevel simd_, int timingFrequency_)
+    : container(std::move(container_)),
+      simd(simd_),
       out(std::move(writer_)),
       dt(dt_),
       outputFrequency(outputFrequency_),
-      filename(std::move(filename_)) {
+      filename(std::move(filename_)),
+      timingFrequency(timingFrequency_) {
     dt_sq = std::pow(dt, 2);
+    addForce(std::move(method_), 1);
 }
 
-void Simulation::run(double start, double end) {
+void Simulation::setCheckpoint(std::shared_ptr<Writer> writer,
+                               int frequency) {
+    checkpointWriter = std::move(writer);
+    checkpointFrequency = frequency;
+}
+
+void Simulation::setReorderFrequency(int frequency) {
+    reorderFrequency = frequency;
+}
+
+void Simulation::setFused(bool fused_) { fused = fused_; }
+
+void Simulation::setAdaptive(double maxDisplacement_, double minStep_) {
+    if (maxDisplacement_ > 0 && forces.size() > 1) {
+        throw std::invalid_argument(
+            "The adaptive time stepping only supports a single force");
+    }
+    maxDisplacement = maxDisplacement_;
+    minStep = minStep_;
+}
+
+void Simulation::addForce(std::shared_ptr<Force> method, int interval) {
+    if (maxDisplacement > 0 && !forces.empty()) {
+        throw std::invalid_argument(
+            "The adaptive time stepping only supports a single force");
+    }
+    ForceFunction function = selectForceFunction(*method, simd);
+    ForceTerm term = {std::move(method), function, interval};
+    // stable, so forces of the same interval keep their order
+    auto position = std::upper_bound(
+        forces.begin(), forces.end(), interval,
+        [](int i, const ForceTerm& other) { return i > other.interval; });
+    forces.insert(position, std::move(term));
+}
+
+double Simulation::calculateMultipleForces(int iteration) {
+    // the slowest forces first, so the sum is only scaled down afterwards
+    int weight = 0;
+    for (const ForceTerm& term : forces) {
+        if ((iteration + 1) % term.interval != 0) {
+            continue;
+        }
+        if (weight > 0) {
+            if (weight != term.interval) {
+                container.scaleForces((double)weight / term.interval);
+            }
+            container.keepForces();
+        }
+        term.function(container, *term.method);
+        weight = term.interval;
+    }
+    return weight * dt / 2;
+}
+
+int Simulation::integrateAdaptively(int iteration) {
+    int substeps = 0;
+    double remaining = dt;
+    while (remaining > 0) {
+        double h;
+        {
+            TIME_PHASE(timer, position);
+            h = std::max(calculateTimeStep(container, maxDisplacement),
+                         minStep);
+            // equal substeps for the rest of the iteration, so none of them
+            // gets much shorter than necessary to end at the iteration
+            const double count = std::ceil(remaining / h);
+            if (count <= 1) {
+                h = remaining;
+                remaining = 0;
+            } else {
+                h = remaining / count;
+                remaining -= h;
+            }
+            calculateX(container, h, h * h);
+            applyBoundaries(iteration);
+        }
+        {
+            TIME_PHASE(timer, force);
+            forces.front().function(container, *forces.front().method);
+        }
+        {
+            TIME_PHASE(timer, velocity);
+            calculateV(container, h);
+        }
+        substeps++;
+    }
+    return substeps;
+}
+
+void Simulation::applyBoundaries(int iteration) {
+    const std::size_t removed = container.applyBoundaries();
+    if (removed > 0) {
+        SPDLOG_LOGGER_DEBUG(logging::file(),
+                            "{} particles left the domain in iteration {}, "
+                            "{} remain",
+                            removed, iteration, container.size());
+    }
+}
+
+void Simulation::run(double start, double end, int firstIteration) {
     spdlog::get("file")->debug("Expected iterations: {}", (end / dt));
-    for (int iteration = 0; iteration <= (end / dt); iteration++) {
-        calculateX(container, dt, dt_sq);
-        calculateF(container, method);
-        calculateV(container, dt);
+#ifndef NO_TIMING
+    timer.reset();
+#else
+    if (timingFrequency > 0) {
+        spdlog::get("console")->warn(
+            "The timing was disabled at compile time (NO_TIMING), it will not "
+            "be reported");
+    }
+#endif
+    const std::size_t initialCount = container.size();
+    int iteration = firstIteration;
+    int lastCheckpoint = -1;
+    // if the velocities are half a step ahead in the fused mode
+    bool halfStep = false;
+    // r-RESPA kicks the velocities with the forces due in an iteration
+    // before and after it
+    const bool multiple = forces.size() > 1;
+    double kick = 0;
+    bool pendingKick = false;
+    // the steps of the adaptive time stepping
+    long substeps = 0;
+    if (multiple) {
+        TIME_PHASE(timer, force);
+        kick = calculateMultipleForces(firstIteration - 1);
+        pendingKick = kick > 0;
+    }
+    for (; iteration <= (end / dt); iteration++) {
+#ifndef NO_OUT_FILE
+        const bool output = iteration >= start / dt &&
+                            ((iteration % outputFrequency) ==
+                             ((int)(start / dt) % outputFrequency));
+#else
+        const bool output = false;
+#endif
+        const bool checkpoint =
+            checkpointWriter && (iteration + 1) % checkpointFrequency == 0;
+
+        if (maxDisplacement > 0) {
+            substeps += integrateAdaptively(iteration);
+        } else {
+            {
+                TIME_PHASE(timer, position);
+                if (multiple) {
+                    if (pendingKick) {
+                        calculateKick(container, kick);
+                    }
+                    // only drifts, the forces are applied by the kicks
+                    calculateX(container, dt, 0.);
+                } else if (fused) {
+                    // also finishes the step of the last iteration
+                    calculateKickDrift(container, halfStep ? dt : dt / 2, dt);
+                    halfStep = true;
+                } else {
+                    calculateX(container, dt, dt_sq);
+                }
+                applyBoundaries(iteration);
+            }
+            {
+                TIME_PHASE(timer, force);
+                if (multiple) {
+                    kick = calculateMultipleForces(iteration);
+                } else {
+                    forces.front().function(container, *forces.front().method);
+                }
+            }
+            {
+                TIME_PHASE(timer, velocity);
+                const bool finished =
+                    output || checkpoint || iteration + 1 > end / dt;
+                if (multiple) {
+                    // the kick after these forces and the kick before the next
+                    // iteration at once, unless the velocities are needed
+                    if (kick > 0) {
+                        calculateKick(container, finished ? kick : 2 * kick);
+                    }
+                    pendingKick = finished && kick > 0;
+                } else if (!fused) {
+                    calculateV(container, dt);
+                } else if (finished) {
+                    // the velocities of this iteration are needed
+                    calculateKick(container, dt / 2);
+                    halfStep = false;
+                }
+            }
+        }
 
 // if NO_OUT_FILE is defined, the compiler will not
 // include this line
@@ -33,11 +220,67 @@ void Simulation::run(double start, double end) {
 // intended for maximum speed or casual testing, DO NOT USE while doing actual
 // calculations
 #ifndef NO_OUT_FILE
-        if (iteration >= start / dt &&
-            ((iteration % outputFrequency) ==
-             ((int)(start / dt) % outputFrequency))) {
+        if (output) {
+            TIME_PHASE(timer, output);
             out->plotParticles(container, filename, iteration);
         }
 #endif
+
+        if (checkpoint) {
+            TIME_PHASE(timer, output);
+            checkpointWriter->plotParticles(container, filename, iteration);
+            lastCheckpoint = iteration;
+        }
+
+        if (reorderFrequency > 0 && (iteration + 1) % reorderFrequency == 0) {
+            TIME_PHASE(timer, reorder);
+            container.reorder();
+        }
+
+#ifndef NO_TIMING
+        if (timingFrequency > 0 &&
+            (iteration + 1 - firstIteration) % timingFrequency == 0) {
+            spdlog::get("file")->info(timer.summary(
+                iteration + 1 - firstIteration, container.size()));
+        }
+#endif
+    }
+
+    {
+        TIME_PHASE(timer, output);
+        if (checkpointWriter) {
+            // the final state, so the run can be continued with a later end
+            if (iteration > firstIteration &&
+                lastCheckpoint != iteration - 1) {
+                checkpointWriter->plotParticles(container, filename,
+                                                iteration - 1);
+            }
+            checkpointWriter->flush();
+        }
+        // asynchronous writers might still be writing
+        out->flush();
+    }
+
+#ifndef NO_TIMING
+    spdlog::get("file")->info(
+        timer.summary(iteration - firstIteration, container.size()));
+#endif
+
+    if (maxDisplacement > 0) {
+        spdlog::get("file")->info(
+            "The adaptive time stepping took {} steps in {} iterations",
+            substeps, iteration - firstIteration);
+    }
+
+    if (container.size() != initialCount) {
+        spdlog::get("file")->info("{} of {} particles left the domain",
+                                  initialCount - container.size(),
+                                  initialCount);
+    }
+
+    if (container.getSkin() > 0) {
+        spdlog::get("file")->info(
+            "Verlet lists were rebuilt {} times in {} iterations",
+            container.getRebuildCount(), iteration - firstIteration);
     }
 }
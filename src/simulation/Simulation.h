@@ -2,10 +2,14 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "container/ParticleContainer.h"
 #include "force/Force.h"
 #include "outputWriter/Writer.h"
+#include "simulation/PhaseTimer.h"
+#include "simulation/StoermerVerlet.h"
+#include "utils/Simd.h"
 
 class Simulation {
    private:
@@ -17,10 +21,41 @@ class Simulation {
 
     /**
      * \brief
-     *  The method to calculate the force.
-     *  This will be used to calculate all forces between the particles in container.
+     *  A force between the particles and the interval it is evaluated at
      */
-    std::shared_ptr<Force> method;
+    struct ForceTerm {
+        /**
+         * \brief
+         *  The method to calculate the force.
+         */
+        std::shared_ptr<Force> method;
+
+        /**
+         * \brief
+         *  The force calculation specialized for the type of method.
+         *  Selected once, so the pair loop does not need virtual calls.
+         */
+        ForceFunction function;
+
+        /**
+         * \brief
+         *  The force is evaluated every interval iterations.
+         */
+        int interval;
+    };
+
+    /**
+     * \brief
+     *  All forces between the particles, sorted by decreasing interval. The
+     *  first force given to the constructor is evaluated every iteration.
+     */
+    std::vector<ForceTerm> forces;
+
+    /**
+     * \brief
+     *  The instruction set used for the force calculations.
+     */
+    SimdLevel simd;
 
     /**
      * \brief
@@ -54,14 +89,69 @@ class Simulation {
      */
     std::string filename;
 
+    /**
+     * \brief
+     *  The interval in iterations at which the timing is reported during the
+     *  run, 0 only reports it at the end.
+     */
+    int timingFrequency;
+
+    /**
+     * \brief
+     *  Writes the checkpoints, nullptr if none are written.
+     */
+    std::shared_ptr<Writer> checkpointWriter;
+
+    /**
+     * \brief
+     *  The interval in iterations at which checkpoints are written.
+     */
+    int checkpointFrequency = 0;
+
+    /**
+     * \brief
+     *  The interval in iterations at which the particles are sorted along a
+     *  space-filling curve, 0 never sorts them.
+     */
+    int reorderFrequency = 0;
+
+    /**
+     * \brief
+     *  If the velocity update of an iteration is fused with the position
+     *  update of the next one.
+     */
+    bool fused = false;
+
+    /**
+     * \brief
+     *  The largest distance a particle may move in one step of the adaptive
+     *  time stepping, 0 uses the fixed time step dt.
+     */
+    double maxDisplacement = 0;
+
+    /**
+     * \brief
+     *  The smallest step of the adaptive time stepping.
+     */
+    double minStep = 0;
+
+#ifndef NO_TIMING
+    /**
+     * \brief
+     *  Measures the time of the phases of the run.
+     */
+    PhaseTimer timer;
+#endif
+
    public:
    /**
     * \brief
     *  Construct a new Simulation object.
     *  This will act like a struct for all the required constants.
     *  Calling run() on the object will start the actual simulation
-    * \param container
+    * \param container_
     *  The particle container containing all particles for the simulation.
+    *  Move it into the simulation to avoid copying the particles.
     * \param method_
     *  The method to calculate the force.
     *  This will be used to calculate all forces between the particles in container.
@@ -74,10 +164,97 @@ class Simulation {
     *  For every n-th iteration. (calculated by iteration % n)
     * \param filename_
     *  The prefix for the files that are going to get outputted.
+    * \param simd_
+    *  The instruction set used for the force calculation, if the force has a
+    *  vectorized kernel. Has to be supported by the CPU.
+    * \param timingFrequency_
+    *  The interval in iterations at which the time of the phases is reported
+    *  to the file logger, 0 only reports it at the end of the run.
+    *  Ignored if the timing is compiled out (NO_TIMING).
     */
-    Simulation(ParticleContainer& container_, std::shared_ptr<Force> method_,
+    Simulation(ParticleContainer container_, std::shared_ptr<Force> method_,
                std::shared_ptr<Writer> writer_, double dt_, int outputFrequency,
-               std::string filename_);
+               std::string filename_, SimdLevel simd_ = simd::detect(),
+               int timingFrequency_ = 0);
+
+    /**
+     * \brief
+     *  Writes checkpoints of the particles during the run and at its end.
+     *  The checkpoint is named after the output files.
+     * \param writer
+     *  Writes the checkpoints, e.g. a CheckpointWriter
+     * \param frequency
+     *  The interval in iterations at which checkpoints are written, has to be
+     *  positive
+     */
+    void setCheckpoint(std::shared_ptr<Writer> writer, int frequency);
+
+    /**
+     * \brief
+     *  Sorts the particles along a space-filling curve during the run, so
+     *  neighbours stay close in memory while the particles move.
+     *  This changes the order of the particles in the output.
+     * \param frequency
+     *  The interval in iterations, 0 never sorts the particles
+     */
+    void setReorderFrequency(int frequency);
+
+    /**
+     * \brief
+     *  Fuses the velocity update of an iteration with the position update of
+     *  the next one and the reset of the forces into a single sweep over the
+     *  particles (velocity Verlet). The velocities are only finished in
+     *  iterations with output, checkpoints and at the end of the run.
+     *  The results are the same up to rounding. The time of the sweep is
+     *  reported as the position phase.
+     * \param fused_
+     *  If the updates are fused
+     */
+    void setFused(bool fused_);
+
+    /**
+     * \brief
+     *  Adapts the time step to the particles: every iteration is divided into
+     *  substeps, so that no particle moves further than maxDisplacement in
+     *  one of them, estimated from its velocity and acceleration. dt becomes
+     *  the largest step, and the substeps of an iteration end exactly at its
+     *  end, so output and checkpoints stay at the times of the fixed time
+     *  step. Close encounters get small steps without slowing down the rest
+     *  of the run. Replaces the fused mode and supports a single force only.
+     * \param maxDisplacement_
+     *  The largest distance a particle may move in one step, 0 uses the
+     *  fixed time step dt
+     * \param minStep_
+     *  The smallest step, has to be positive. Limits the amount of substeps
+     *  if particles get too close.
+     * \throws std::invalid_argument
+     *  If the adaptive time stepping is enabled while several forces were
+     *  added with addForce
+     */
+    void setAdaptive(double maxDisplacement_, double minStep_);
+
+    /**
+     * \brief
+     *  Adds a force, which is evaluated every interval iterations. With
+     *  forces of different intervals the run uses the r-RESPA multiple time
+     *  stepping: a force kicks the velocities with interval * dt / 2 before
+     *  and after every interval, so slowly varying forces can be evaluated
+     *  less often than the others.
+     *  All forces use the cutoff of the container, except planets with an
+     *  opening angle. The velocities of iterations in the middle of an
+     *  interval of a force contain its first kick, and the written force is
+     *  the weighted sum of the forces evaluated in the iteration.
+     *  Replaces the fused mode.
+     * \param method
+     *  The force between the particles
+     * \param interval
+     *  The force is evaluated every interval iterations, has to be positive.
+     *  The first iteration of the run and restarts should be multiples of
+     *  all intervals.
+     * \throws std::invalid_argument
+     *  If a second force is added to the adaptive time stepping
+     */
+    void addForce(std::shared_ptr<Force> method, int interval);
 
     /**
      * \brief
@@ -90,6 +267,44 @@ class Simulation {
      * \param end
      *  The end point of the simulation. This will be the last time step calculated.
      *  The function will return afterwards.
+     * \param firstIteration
+     *  The first iteration to calculate. When restarting from a checkpoint
+     *  this is the iteration after the one stored in the checkpoint, so the
+     *  run continues where it was stopped.
     */
-    void run(double start, double end);
+    void run(double start, double end, int firstIteration = 0);
+
+   private:
+    /**
+     * \brief
+     *  Calculates the forces due at the end of the iteration for r-RESPA.
+     *  The forces are summed up weighted with their intervals, divided by
+     *  the smallest one, so the container holds them for the kicks until
+     *  the next evaluation even if particles are sorted or removed.
+     * \param iteration
+     *  The forces whose interval divides iteration + 1 are evaluated
+     * \return
+     *  The time to kick the velocities with the summed forces for half of
+     *  the intervals, 0 if no force was evaluated
+     */
+    double calculateMultipleForces(int iteration);
+
+    /**
+     * \brief
+     *  Integrates one iteration with the substeps of the adaptive time
+     *  stepping, the last one ending exactly after dt.
+     * \param iteration
+     *  The current iteration, for the log
+     * \return
+     *  The amount of substeps
+     */
+    int integrateAdaptively(int iteration);
+
+    /**
+     * \brief
+     *  Applies the boundaries of the domain and logs the particles leaving it.
+     * \param iteration
+     *  The current iteration, for the log
+     */
+    void applyBoundaries(int iteration);
 };
\ No newline at end of file
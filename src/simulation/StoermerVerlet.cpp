@@ -1,35 +1,401 @@
 #include "StoermerVerlet.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "force/CentralForce.h"
+#include "force/LennardJonesKernel.h"
+#include "force/LennardJonesMixture.h"
+#include "force/LennardJonesMolecule.h"
+#include "force/LennardJonesShifted.h"
+#include "force/LennardJonesSmooth.h"
+#include "force/Planet.h"
+#include "force/TabulatedForce.h"
+
+namespace {
+/**
+ * Moves all particles and returns the largest squared distance of a particle
+ * to its reference position if Track is set.
+ */
+template <bool Track>
+double updatePositions(ParticleContainer &container, const double dt,
+                       const double dt_sq) {
+    const std::size_t n = container.size();
+    double *__restrict x = container.position(0);
+    double *__restrict y = container.position(1);
+    double *__restrict z = container.position(2);
+    const double *__restrict vx = container.velocity(0);
+    const double *__restrict vy = container.velocity(1);
+    const double *__restrict vz = container.velocity(2);
+    const double *__restrict fx = container.force(0);
+    const double *__restrict fy = container.force(1);
+    const double *__restrict fz = container.force(2);
+    const double *__restrict m = container.mass();
+    const double *__restrict rx = container.getReferencePosition(0);
+    const double *__restrict ry = container.getReferencePosition(1);
+    const double *__restrict rz = container.getReferencePosition(2);
+
+    double maxDisplacementSq = 0;
+#pragma omp parallel for simd schedule(static) \
+    reduction(max : maxDisplacementSq)
+    for (std::size_t i = 0; i < n; i++) {
+        double factor = dt_sq / (2 * m[i]);
+        x[i] += dt * vx[i] + factor * fx[i];
+        y[i] += dt * vy[i] + factor * fy[i];
+        z[i] += dt * vz[i] + factor * fz[i];
+
+        if constexpr (Track) {
+            double dx = x[i] - rx[i];
+            double dy = y[i] - ry[i];
+            double dz = z[i] - rz[i];
+            maxDisplacementSq =
+                std::max(maxDisplacementSq, dx * dx + dy * dy + dz * dz);
+        }
+    }
+    return maxDisplacementSq;
+}
+}  // namespace
+
 void calculateX(ParticleContainer &container, const double dt,
                 const double dt_sq) {
-    for (Particle &p : container) {
-        std::array<double, 3> res =
-            (dt * p.getV()) + (dt_sq / (2 * p.getM())) * p.getF();
-        p.addX(res);
+    // the Verlet lists need to know how far the particles moved
+    if (container.getReferencePosition(0) != nullptr) {
+        container.updateDisplacement(
+            updatePositions<true>(container, dt, dt_sq));
+    } else {
+        updatePositions<false>(container, dt, dt_sq);
+    }
+}
+
+double calculateTimeStep(const ParticleContainer &container,
+                         const double maxDisplacement) {
+    const std::size_t n = container.size();
+    const double *__restrict vx = container.velocity(0);
+    const double *__restrict vy = container.velocity(1);
+    const double *__restrict vz = container.velocity(2);
+    const double *__restrict fx = container.force(0);
+    const double *__restrict fy = container.force(1);
+    const double *__restrict fz = container.force(2);
+    const double *__restrict m = container.mass();
+
+    double minStep = std::numeric_limits<double>::infinity();
+#pragma omp parallel for simd schedule(static) reduction(min : minStep)
+    for (std::size_t i = 0; i < n; i++) {
+        const double speed = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i] +
+                                       vz[i] * vz[i]);
+        const double acceleration =
+            std::sqrt(fx[i] * fx[i] + fy[i] * fy[i] + fz[i] * fz[i]) / m[i];
+        // the positive root of |v| dt + |a| dt^2 / 2 = maxDisplacement,
+        // without cancellation
+        const double step =
+            2 * maxDisplacement /
+            (speed + std::sqrt(speed * speed +
+                               2 * acceleration * maxDisplacement));
+        minStep = std::min(minStep, step);
+    }
+    return minStep;
+}
+
+namespace {
+/**
+ * Kicks the velocities, drifts the positions and clears the old forces in one
+ * sweep. Returns the largest squared distance of a particle to its reference
+ * position if Track is set.
+ */
+template <bool Track>
+double kickDrift(ParticleContainer &container, const double kick,
+                 const double dt) {
+    const std::size_t n = container.size();
+    double *__restrict x = container.position(0);
+    double *__restrict y = container.position(1);
+    double *__restrict z = container.position(2);
+    double *__restrict vx = container.velocity(0);
+    double *__restrict vy = container.velocity(1);
+    double *__restrict vz = container.velocity(2);
+    const double *__restrict fx = container.force(0);
+    const double *__restrict fy = container.force(1);
+    const double *__restrict fz = container.force(2);
+    double *__restrict old_fx = container.oldForce(0);
+    double *__restrict old_fy = container.oldForce(1);
+    double *__restrict old_fz = container.oldForce(2);
+    const double *__restrict m = container.mass();
+    const double *__restrict rx = container.getReferencePosition(0);
+    const double *__restrict ry = container.getReferencePosition(1);
+    const double *__restrict rz = container.getReferencePosition(2);
+
+    double maxDisplacementSq = 0;
+#pragma omp parallel for simd schedule(static) \
+    reduction(max : maxDisplacementSq)
+    for (std::size_t i = 0; i < n; i++) {
+        double factor = kick / m[i];
+        vx[i] += factor * fx[i];
+        vy[i] += factor * fy[i];
+        vz[i] += factor * fz[i];
+        x[i] += dt * vx[i];
+        y[i] += dt * vy[i];
+        z[i] += dt * vz[i];
+        // become the forces of the next iteration
+        old_fx[i] = 0.;
+        old_fy[i] = 0.;
+        old_fz[i] = 0.;
+
+        if constexpr (Track) {
+            double dx = x[i] - rx[i];
+            double dy = y[i] - ry[i];
+            double dz = z[i] - rz[i];
+            maxDisplacementSq =
+                std::max(maxDisplacementSq, dx * dx + dy * dy + dz * dz);
+        }
+    }
+    return maxDisplacementSq;
+}
+}  // namespace
+
+void calculateKickDrift(ParticleContainer &container, const double kick,
+                        const double dt) {
+    if (container.getReferencePosition(0) != nullptr) {
+        container.updateDisplacement(kickDrift<true>(container, kick, dt));
+    } else {
+        kickDrift<false>(container, kick, dt);
+    }
+    container.swapClearedForces();
+}
+
+void calculateKick(ParticleContainer &container, const double kick) {
+    const std::size_t n = container.size();
+    double *__restrict vx = container.velocity(0);
+    double *__restrict vy = container.velocity(1);
+    double *__restrict vz = container.velocity(2);
+    const double *__restrict fx = container.force(0);
+    const double *__restrict fy = container.force(1);
+    const double *__restrict fz = container.force(2);
+    const double *__restrict m = container.mass();
+
+#pragma omp parallel for simd schedule(static)
+    for (std::size_t i = 0; i < n; i++) {
+        double factor = kick / m[i];
+        vx[i] += factor * fx[i];
+        vy[i] += factor * fy[i];
+        vz[i] += factor * fz[i];
     }
 }
 
 void calculateV(ParticleContainer &container, double dt) {
-    for (Particle &p : container) {
-        std::array<double, 3> res =
-            (dt / (2 * p.getM())) * (p.getF() + p.getOldF());
-        p.addV(res);
+    const std::size_t n = container.size();
+    double *__restrict vx = container.velocity(0);
+    double *__restrict vy = container.velocity(1);
+    double *__restrict vz = container.velocity(2);
+    const double *__restrict fx = container.force(0);
+    const double *__restrict fy = container.force(1);
+    const double *__restrict fz = container.force(2);
+    const double *__restrict old_fx = container.oldForce(0);
+    const double *__restrict old_fy = container.oldForce(1);
+    const double *__restrict old_fz = container.oldForce(2);
+    const double *__restrict m = container.mass();
+
+    // one loop for all dimensions, so there is only one parallel region
+#pragma omp parallel for simd schedule(static)
+    for (std::size_t i = 0; i < n; i++) {
+        double factor = dt / (2 * m[i]);
+        vx[i] += factor * (fx[i] + old_fx[i]);
+        vy[i] += factor * (fy[i] + old_fy[i]);
+        vz[i] += factor * (fz[i] + old_fz[i]);
     }
 }
 
-void calculateF(ParticleContainer &container,
-                const std::shared_ptr<Force> method) {
-    for (Particle &p : container) {
-        p.nextIteration();
+namespace {
+/**
+ * Adapts the templated force calculation to the ForceFunction signature.
+ */
+template <typename ForceT>
+void calculateFAs(ParticleContainer &container, const Force &method) {
+    calculateF(container, static_cast<const ForceT &>(method));
+}
+
+/**
+ * Calculates a tabulated force with the interpolation of the table fixed at
+ * compile time
+ */
+template <Interpolation Order>
+void calculateFTabulated(ParticleContainer &container, const Force &method) {
+    calculateF(container, TabulatedForce::Interpolator<Order>{
+                              static_cast<const TabulatedForce &>(method)});
+}
+
+/**
+ * Calculates the Lennard-Jones forces of a single type or, if ForceT is
+ * LennardJonesMixture, of a mixture with the given block kernel.
+ */
+template <typename ForceT, LJBlockKernel Kernel>
+void calculateFLennardJones(ParticleContainer &container,
+                            const Force &method) {
+    const auto &lj = static_cast<const ForceT &>(method);
+    container.nextIteration();
+
+    const double cutoff = container.getCutoff();
+    const double cutoff_sq =
+        cutoff > 0 ? cutoff * cutoff : std::numeric_limits<double>::max();
+
+    container.forEachNeighbourBlockParallel([&](double *fx, double *fy,
+                                                double *fz) {
+        LJKernelData data = {container.position(0),
+                             container.position(1),
+                             container.position(2),
+                             fx,
+                             fy,
+                             fz,
+                             0,
+                             0,
+                             cutoff_sq};
+        if constexpr (std::is_same_v<ForceT, LennardJonesMixture>) {
+            data.type = container.type();
+            data.epsilon_24_table = lj.getEpsilon24Table();
+            data.sigma_sq_table = lj.getSigmaSqTable();
+            data.types = lj.getTypes();
+        } else {
+            data.epsilon_24 = lj.getEpsilon24();
+            data.sigma_sq = lj.getSigmaSq();
+        }
+        return [data](std::size_t i, const std::size_t *neighbours,
+                      std::size_t count) {
+            Kernel(data, i, neighbours, count);
+        };
+    });
+}
+/**
+ * Calculates a force which only provides calculateForce, like a plugin which
+ * is no central force, on copies of the two particles of every pair closer
+ * than the cutoff.
+ */
+void calculateFParticles(ParticleContainer &container, const Force &method) {
+    container.nextIteration();
+
+    const double cutoff = container.getCutoff();
+    const double cutoff_sq =
+        cutoff > 0 ? cutoff * cutoff : std::numeric_limits<double>::max();
+
+    container.forEachNeighbourBlockParallel([&](double *fx, double *fy,
+                                                double *fz) {
+        const double *x = container.position(0);
+        const double *y = container.position(1);
+        const double *z = container.position(2);
+        const double *vx = container.velocity(0);
+        const double *vy = container.velocity(1);
+        const double *vz = container.velocity(2);
+        const double *m = container.mass();
+        const int *t = container.type();
+        return [=, &container, &method](std::size_t i,
+                                        const std::size_t *neighbours,
+                                        std::size_t count) {
+            Particle p1({x[i], y[i], z[i]}, {vx[i], vy[i], vz[i]}, m[i], t[i]);
+            for (std::size_t k = 0; k < count; k++) {
+                const std::size_t j = neighbours[k];
+                const double dx = x[i] - x[j];
+                const double dy = y[i] - y[j];
+                const double dz = z[i] - z[j];
+                if (dx * dx + dy * dy + dz * dz > cutoff_sq) {
+                    continue;
+                }
+                // the ghosts have no velocities of their own
+                const std::size_t origin = container.originOf(j);
+                Particle p2({x[j], y[j], z[j]},
+                            {vx[origin], vy[origin], vz[origin]}, m[j], t[j]);
+                const std::array<double, 3> f =
+                    method.calculateForce(p1, p2);
+                fx[i] += f[0];
+                fy[i] += f[1];
+                fz[i] += f[2];
+                // Newton's third law
+                fx[j] -= f[0];
+                fy[j] -= f[1];
+                fz[j] -= f[2];
+            }
+        };
+    });
+}
+
+/**
+ * Calculates the gravity between planets with the Barnes-Hut approximation.
+ * Every particle only sums up the force on itself, so the particles can be
+ * distributed among the threads without conflicts.
+ */
+void calculateFBarnesHut(ParticleContainer &container, const Force &method) {
+    const auto &planet = static_cast<const Planet &>(method);
+    container.nextIteration();
+
+    const Octree &tree = container.buildOctree();
+    const double theta = planet.getTheta();
+    const std::size_t n = container.size();
+    double *fx = container.force(0);
+    double *fy = container.force(1);
+    double *fz = container.force(2);
+
+    // particles close on the Morton curve traverse similar nodes
+#pragma omp parallel for schedule(dynamic, 64)
+    for (std::size_t k = 0; k < n; k++) {
+        const std::size_t i = tree.particleAt(k);
+        const std::array<double, 3> f = tree.calculateForce(k, planet, theta);
+        // added, so the forces can be summed up with other ones
+        fx[i] += f[0];
+        fy[i] += f[1];
+        fz[i] += f[2];
     }
+}
+}  // namespace
 
-    for (auto iterator = container.begin(); iterator != container.end();
-         iterator++) {
-        for (auto inner = iterator + 1; inner != container.end(); inner++) {
-            std::array<double, 3> f = method->calculateForce(*iterator, *inner);
-            (*iterator).addF(f);
-            std::array<double, 3> invF = -1 * f;
-            (*inner).addF(invF);
+ForceFunction selectForceFunction(const Force &method, SimdLevel level) {
+    if (dynamic_cast<const LennardJonesMolecule *>(&method) != nullptr) {
+        switch (level) {
+            case SimdLevel::avx512:
+                return calculateFLennardJones<LennardJonesMolecule,
+                                              ljkernel::blockAVX512>;
+            case SimdLevel::avx2:
+                return calculateFLennardJones<LennardJonesMolecule,
+                                              ljkernel::blockAVX2>;
+            case SimdLevel::scalar:
+                break;
         }
+        return calculateFAs<LennardJonesMolecule>;
     }
-}
\ No newline at end of file
+    if (dynamic_cast<const LennardJonesMixture *>(&method) != nullptr) {
+        switch (level) {
+            case SimdLevel::avx512:
+                return calculateFLennardJones<LennardJonesMixture,
+                                              ljkernel::mixtureAVX512>;
+            case SimdLevel::avx2:
+                return calculateFLennardJones<LennardJonesMixture,
+                                              ljkernel::mixtureAVX2>;
+            case SimdLevel::scalar:
+                break;
+        }
+        return calculateFAs<LennardJonesMixture>;
+    }
+    if (dynamic_cast<const LennardJonesShifted *>(&method) != nullptr) {
+        return calculateFAs<LennardJonesShifted>;
+    }
+    if (dynamic_cast<const LennardJonesSmooth *>(&method) != nullptr) {
+        return calculateFAs<LennardJonesSmooth>;
+    }
+    if (const auto *table = dynamic_cast<const TabulatedForce *>(&method)) {
+        if (table->getInterpolation() == Interpolation::cubic) {
+            return calculateFTabulated<Interpolation::cubic>;
+        }
+        return calculateFTabulated<Interpolation::linear>;
+    }
+    if (const auto *planet = dynamic_cast<const Planet *>(&method)) {
+        if (planet->getTheta() > 0) {
+            return calculateFBarnesHut;
+        }
+        return calculateFAs<Planet>;
+    }
+    if (dynamic_cast<const CentralForce *>(&method) != nullptr) {
+        return calculateFAs<CentralForce>;
+    }
+    return calculateFParticles;
+}
+
+void calculateF(ParticleContainer &container,
+                const std::shared_ptr<Force> method) {
+    selectForceFunction(*method)(container, *method);
+}
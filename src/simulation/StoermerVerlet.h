@@ -1,10 +1,14 @@
 #pragma once
 
+#include <limits>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #include "container/Particle.h"
 #include "container/ParticleContainer.h"
 #include "force/Force.h"
+#include "utils/Simd.h"
 #include "utils/ArrayUtils.h"
 
 /** \brief
@@ -37,9 +41,198 @@ void calculateX(ParticleContainer& container, double dt, double dt_sq);
  */
 void calculateV(ParticleContainer& container, double dt);
 
+/** \brief
+ *  The fused step of the velocity Verlet form of Störmer-Verlet. Kicks the
+ *  velocities with the current forces, v += kick / m * F, drifts the
+ *  positions, x += dt * v, and prepares the forces of the next iteration in
+ *  a single sweep over the particles, so the force calculation does not
+ *  reset them again.
+ *  With kick = dt / 2 this starts a step from the velocities of the current
+ *  iteration. With kick = dt it also finishes the previous step, whose
+ *  velocities are then never formed. Afterwards the velocities are half a
+ *  step ahead until calculateKick finishes the step.
+ *  The positions are the same as with calculateX up to rounding.
+ *
+ *  \param container
+ *  The ParticleContainer containing all particles
+ *
+ *  \param kick
+ *  The time the velocities are kicked with the current forces, dt / 2 or dt
+ *
+ *  \param dt
+ *  The time difference between iteration steps
+ */
+void calculateKickDrift(ParticleContainer& container, double kick, double dt);
+
+/** \brief
+ *  Kicks the velocities with the current forces, v += kick / m * F. With
+ *  kick = dt / 2 this finishes a step of calculateKickDrift, so the
+ *  velocities belong to the current iteration again.
+ *
+ *  \param container
+ *  The ParticleContainer containing all particles
+ *
+ *  \param kick
+ *  The time the velocities are kicked with the current forces
+ */
+void calculateKick(ParticleContainer& container, double kick);
+
+/** \brief
+ *  Calculates the largest time step in which no particle moves further than
+ *  the given distance, estimated from its velocity and the acceleration by
+ *  the current force, |v| dt + |a| dt^2 / 2 <= maxDisplacement.
+ *
+ *  \param container
+ *  The ParticleContainer containing all particles
+ *
+ *  \param maxDisplacement
+ *  The largest distance a particle may move in one step, has to be positive
+ *
+ *  \return
+ *  The time step, infinity if all particles rest without force
+ */
+double calculateTimeStep(const ParticleContainer& container,
+                         double maxDisplacement);
+
+namespace detail {
+/**
+ * Detects forces depending on the types of the particles, which provide
+ * calculatePairScalar(distanceSq, type1, type2)
+ */
+template <typename ForceT, typename = void>
+struct isTyped : std::false_type {};
+
+template <typename ForceT>
+struct isTyped<ForceT, std::void_t<decltype(std::declval<const ForceT&>()
+                                                .calculatePairScalar(0., 0, 0))>>
+    : std::true_type {};
+
+/**
+ * Returns the scalar of the force between two particles, by their types if
+ * the force depends on them and otherwise by their masses
+ */
+template <typename ForceT>
+inline double pairScalar(const ForceT& method, double distanceSq, double m1,
+                         double m2, int t1, int t2) {
+    if constexpr (isTyped<ForceT>::value) {
+        return method.calculatePairScalar(distanceSq, t1, t2);
+    } else {
+        return method.calculateScalar(distanceSq, m1, m2);
+    }
+}
+}  // namespace detail
+
+/** \brief
+ *  Calculates the new force for all particles in the particle container with
+ *  the given force, which is known at compile time.
+ *  If ForceT is a final class, calls to it are resolved at compile time and
+ *  can be inlined into the pair loop.
+ *  ForceT has to provide calculateScalar like a CentralForce.
+ *  Forces providing calculatePairScalar get the types of the particles
+ *  instead of their masses.
+ *  If the container has a cutoff, only pairs closer than the cutoff interact.
+ *  The pairs are distributed among all OpenMP threads.
+ *
+ *  \tparam ForceT
+ *  The type of the force
+ *
+ *  \param container
+ *  The ParticleContainer containing all particles the force shall be calculated
+ *
+ *  \param method
+ *  The force equation that describes the system
+ *
+ */
+template <typename ForceT>
+void calculateF(ParticleContainer& container, const ForceT& method) {
+    container.nextIteration();
+
+    const double cutoff = container.getCutoff();
+    const double cutoff_sq = cutoff > 0 ? cutoff * cutoff
+                                        : std::numeric_limits<double>::max();
+
+    container.forEachNeighbourBlockParallel([&](double* fx, double* fy,
+                                                double* fz) {
+        // the ghosts are only appended to the arrays by now
+        const double* x = container.position(0);
+        const double* y = container.position(1);
+        const double* z = container.position(2);
+        const double* m = container.mass();
+        const int* t = container.type();
+        return [=, &method](std::size_t i, const std::size_t* neighbours,
+                            std::size_t count) {
+            const double xi = x[i];
+            const double yi = y[i];
+            const double zi = z[i];
+            const double mi = m[i];
+            const int ti = t[i];
+            double fix = 0;
+            double fiy = 0;
+            double fiz = 0;
+
+            // the neighbours of a block are unique and never i, so the
+            // updates of fx[j] can not conflict
+#pragma omp simd reduction(+ : fix, fiy, fiz)
+            for (std::size_t k = 0; k < count; k++) {
+                const std::size_t j = neighbours[k];
+                const double dx = xi - x[j];
+                const double dy = yi - y[j];
+                const double dz = zi - z[j];
+                const double distanceSq = dx * dx + dy * dy + dz * dz;
+
+                // branchless, pairs outside of the cutoff get a scalar of 0
+                const double s =
+                    distanceSq <= cutoff_sq
+                        ? detail::pairScalar(method, distanceSq, mi, m[j], ti,
+                                             t[j])
+                        : 0.;
+                fix += s * dx;
+                fiy += s * dy;
+                fiz += s * dz;
+                // Newton's third law
+                fx[j] -= s * dx;
+                fy[j] -= s * dy;
+                fz[j] -= s * dz;
+            }
+
+            fx[i] += fix;
+            fy[i] += fiy;
+            fz[i] += fiz;
+        };
+    });
+}
+
+/** \brief
+ *  A force calculation specialized for one type of force
+ */
+using ForceFunction = void (*)(ParticleContainer&, const Force&);
+
+/** \brief
+ *  Selects the specialized force calculation for the dynamic type of the
+ *  given force. Central forces unknown at compile time use the virtual
+ *  calculateScalar, other forces are calculated with calculateForce on
+ *  copies of the particles of every pair.
+ *  Planets with an opening angle use the Barnes-Hut approximation, which
+ *  ignores the cutoff of the container.
+ *  This only has to be done once per simulation.
+ *
+ *  \param method
+ *  The force equation that describes the system
+ *
+ *  \param level
+ *  The instruction set used for the Lennard-Jones kernel, has to be supported
+ *  by the CPU
+ *
+ *  \return
+ *  The force calculation for this force
+ */
+ForceFunction selectForceFunction(const Force& method,
+                                  SimdLevel level = simd::detect());
+
 /** \brief
  *  Calculates the new force for all particles in the particle container with
  * the selected method
+ *  If the container has a cutoff, only pairs closer than the cutoff interact.
  *
  *  \param container
  *  The ParticleContainer containing all particles the force shall be calculated
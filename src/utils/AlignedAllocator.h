@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/**
+ * \brief
+ *  Allocator returning memory aligned to the given boundary.
+ *  Aligning the particle arrays to cache lines allows aligned vector loads
+ *  and prevents a vector from being split across two cache lines.
+ * \tparam T
+ *  The type to allocate
+ * \tparam Alignment
+ *  The alignment in bytes, has to be a power of two
+ */
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+   public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    /**
+     * \brief
+     *  Allocates aligned memory for n objects of type T
+     */
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(
+            ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    /**
+     * \brief
+     *  Frees memory allocated by allocate
+     */
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+};
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&,
+                const AlignedAllocator<U, Alignment>&) {
+    return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&,
+                const AlignedAllocator<U, Alignment>&) {
+    return false;
+}
+
+/**
+ * \brief
+ *  A std::vector whose data is aligned to 64 bytes (one cache line)
+ */
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * \brief
+ *  The binary checkpoint format shared by the CheckpointWriter and the
+ *  CheckpointReader.
+ *
+ *  A checkpoint is the Header followed by the particle arrays, each one
+ *  count elements long: x, y, z, vx, vy, vz, fx, fy, fz, old fx, old fy,
+ *  old fz, m (double) and type (int32). The values are stored in the byte
+ *  order of the writing machine, which is recorded in the header.
+ */
+namespace checkpoint {
+
+/**
+ * \brief
+ *  The version of the format, increased on every incompatible change
+ */
+constexpr std::uint32_t VERSION = 1;
+
+/**
+ * \brief
+ *  Written as a number, so the reader can detect a different byte order
+ */
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/**
+ * \brief
+ *  The amount of double arrays after the header
+ */
+constexpr int DOUBLE_ARRAYS = 13;
+
+/**
+ * \brief
+ *  The start of every checkpoint file
+ */
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    /** The amount of particles */
+    std::uint64_t count;
+    /** The last iteration done before the checkpoint was written */
+    std::int64_t iteration;
+    /** The simulation time after that iteration */
+    double time;
+    /** The time step of the simulation */
+    double dt;
+    /** The cutoff radius, 0 if all pairs were calculated */
+    double cutoff;
+    /** The skin of the Verlet lists, 0 if they were disabled */
+    double skin;
+};
+
+static_assert(sizeof(Header) == 64, "the header must not contain padding");
+
+/**
+ * \brief
+ *  Returns a header for the current machine with the magic and version set
+ */
+inline Header makeHeader() {
+    Header header{};
+    std::memcpy(header.magic, "MOLSIMCP", sizeof(header.magic));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    return header;
+}
+
+/**
+ * \brief
+ *  Returns the size of a checkpoint with count particles in bytes
+ */
+inline std::uint64_t fileSize(std::uint64_t count) {
+    return sizeof(Header) +
+           count * (DOUBLE_ARRAYS * sizeof(double) + sizeof(std::int32_t));
+}
+
+}  // namespace checkpoint
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <memory>
+
+/**
+ * \brief
+ *  Cached handles of the loggers created in main.
+ *
+ *  spdlog::get locks the registry and searches it on every call. These
+ *  functions only do this on their first call, so they can be used in hot
+ *  loops. Log there with the SPDLOG_LOGGER_TRACE/DEBUG macros: calls below
+ *  SPDLOG_ACTIVE_LEVEL (the LOG_LEVEL CMake option) are removed by the
+ *  preprocessor, including the evaluation of their arguments.
+ */
+namespace logging {
+
+/**
+ * \brief
+ *  The general file logger
+ */
+inline const std::shared_ptr<spdlog::logger>& file() {
+    static const std::shared_ptr<spdlog::logger> logger = spdlog::get("file");
+    return logger;
+}
+
+/**
+ * \brief
+ *  The logger for errors and critical information on the console
+ */
+inline const std::shared_ptr<spdlog::logger>& console() {
+    static const std::shared_ptr<spdlog::logger> logger =
+        spdlog::get("console");
+    return logger;
+}
+
+}  // namespace logging
@@ -0,0 +1,50 @@
+#include "utils/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+MappedFile::MappedFile(const std::string& filename) {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("could not open file " + filename + ": " +
+                                 std::strerror(errno));
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+        const int error = errno;
+        close(fd);
+        throw std::runtime_error("could not read the size of file " +
+                                 filename + ": " + std::strerror(error));
+    }
+    length = info.st_size;
+
+    // mapping 0 bytes is not allowed
+    if (length > 0) {
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            const int error = errno;
+            close(fd);
+            throw std::runtime_error("could not map file " + filename + ": " +
+                                     std::strerror(error));
+        }
+        // the whole file will be read, so the kernel can read ahead
+        madvise(mapping, length, MADV_WILLNEED);
+        content = static_cast<const char*>(mapping);
+    }
+
+    // the mapping stays valid after closing
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (content != nullptr) {
+        munmap(const_cast<char*>(content), length);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \brief
+ *  A file mapped read-only into memory.
+ *
+ *  The pages are only read from disk when they are accessed, so mapping a
+ *  large file is cheap and reading it does not copy it into a buffer first.
+ */
+class MappedFile {
+   private:
+    /**
+     * \brief
+     *  The start of the mapping, nullptr for empty files
+     */
+    const char* content = nullptr;
+
+    /**
+     * \brief
+     *  The size of the file in bytes
+     */
+    std::size_t length = 0;
+
+   public:
+    /**
+     * \brief
+     *  Maps the file
+     * \param filename
+     *  The path of the file
+     * \throws std::runtime_error
+     *  If the file can not be opened or mapped
+     */
+    explicit MappedFile(const std::string& filename);
+
+    /**
+     * \brief
+     *  Unmaps the file
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * \brief
+     *  Returns the content of the file, it is not null terminated
+     */
+    [[nodiscard]] const char* data() const { return content; }
+
+    /**
+     * \brief
+     *  Returns the size of the file in bytes
+     */
+    [[nodiscard]] std::size_t size() const { return length; }
+};
@@ -9,6 +9,9 @@
 
 #include <random>
 #include <array>
+#include <cstdint>
+
+#include "utils/Philox.h"
 
 /**
  * Generate a random velocity vector according to the Maxwell-Boltzmann distribution, with a given average velocity.
@@ -17,7 +20,7 @@
  * @param dimensions Number of dimensions for which the velocity vector shall be generated. Set this to 2 or 3.
  * @return Array containing the generated velocity vector.
  */
-std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions) {
+inline std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions) {
   // we use a constant seed for repeatability.
   // random engine needs static lifetime otherwise it would be recreated for every call.
   static std::default_random_engine randomEngine(42);
@@ -31,3 +34,33 @@ std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity
   }
   return randomVelocity;
 }
+
+/**
+ * Generate a random velocity vector according to the Maxwell-Boltzmann distribution, with a given average velocity.
+ * Counter-based version: the velocity only depends on the stream and the index, so the vectors can be generated
+ * in any order and in parallel and still be reproducible.
+ *
+ * @param averageVelocity The average velocity of the brownian motion for the system.
+ * @param dimensions Number of dimensions for which the velocity vector shall be generated. Set this to 2 or 3.
+ * @param stream Selects an independent sequence of velocities, e.g. one per cuboid.
+ * @param index The index of the velocity in the sequence, e.g. the index of the particle.
+ * @return Array containing the generated velocity vector.
+ */
+inline std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions,
+                                                                 std::uint32_t stream, std::uint64_t index) {
+  // we use a constant seed for repeatability, like the sequential version
+  const philox::Key key = {42, stream};
+  const auto low = (std::uint32_t)index;
+  const auto high = (std::uint32_t)(index >> 32);
+
+  const std::array<double, 2> first = philox::normal2({low, high, 0, 0}, key);
+  std::array<double, 3> randomVelocity{};
+  randomVelocity[0] = averageVelocity * first[0];
+  if (dimensions > 1) {
+    randomVelocity[1] = averageVelocity * first[1];
+  }
+  if (dimensions > 2) {
+    randomVelocity[2] = averageVelocity * philox::normal2({low, high, 1, 0}, key)[0];
+  }
+  return randomVelocity;
+}
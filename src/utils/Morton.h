@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * \brief
+ *  Morton codes (Z-order curve) of 3D grid coordinates.
+ *  Sorting points by their code groups points close in space, every prefix
+ *  of 3 * L bits identifies one cell of an octree on level L.
+ */
+namespace morton {
+
+/**
+ * \brief
+ *  The amount of bits per dimension, 3 * 21 bits fit into 64 bit
+ */
+constexpr int BITS = 21;
+
+/**
+ * \brief
+ *  The amount of grid positions per dimension
+ */
+constexpr std::uint64_t GRID = std::uint64_t{1} << BITS;
+
+/**
+ * \brief
+ *  Spreads the lower 21 bits of v, so there are two zero bits between
+ *  every bit
+ */
+inline std::uint64_t spread(std::uint64_t v) {
+    v &= GRID - 1;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8) & 0x100f00f00f00f00fULL;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+}
+
+/**
+ * \brief
+ *  Interleaves the bits of the grid coordinates
+ * \param x
+ *  The x coordinate, only the lower 21 bits are used
+ * \param y
+ *  The y coordinate, only the lower 21 bits are used
+ * \param z
+ *  The z coordinate, only the lower 21 bits are used
+ * \return
+ *  The Morton code of the coordinates
+ */
+inline std::uint64_t encode(std::uint64_t x, std::uint64_t y,
+                            std::uint64_t z) {
+    return spread(x) | (spread(y) << 1) | (spread(z) << 2);
+}
+
+/**
+ * \brief
+ *  Maps a position inside of a cube to its grid coordinate
+ * \param position
+ *  The position in one dimension
+ * \param origin
+ *  The lower corner of the cube in this dimension
+ * \param inverseSide
+ *  1 divided by the side length of the cube
+ * \return
+ *  The grid coordinate, clamped to [0, GRID)
+ */
+inline std::uint64_t quantize(double position, double origin,
+                              double inverseSide) {
+    double scaled = (position - origin) * inverseSide * (double)GRID;
+    if (!(scaled > 0)) {
+        return 0;
+    }
+    if (scaled >= (double)(GRID - 1)) {
+        return GRID - 1;
+    }
+    return (std::uint64_t)scaled;
+}
+
+}  // namespace morton
@@ -5,6 +5,7 @@ namespace po = boost::program_options;
 
 #include <spdlog/spdlog.h>
 
+#include <cstdint>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
@@ -13,14 +14,24 @@ namespace po = boost::program_options;
 #include <sstream>
 #include <string>
 
+#include "container/Domain.h"
+#include "force/CentralForce.h"
 #include "force/Force.h"
+#include "force/LennardJonesMixture.h"
 #include "force/LennardJonesMolecule.h"
+#include "force/LennardJonesShifted.h"
+#include "force/LennardJonesSmooth.h"
 #include "force/Planet.h"
+#include "force/TabulatedForce.h"
 #include "input/CuboidGenerator.h"
+#include "outputWriter/AsyncWriter.h"
+#include "outputWriter/VTKBinaryWriter.h"
 #include "outputWriter/VTKWriter.h"
 #include "outputWriter/Writer.h"
 #include "outputWriter/XYZWriter.h"
 #include "utils/ArrayUtils.h"
+#include "utils/Logging.h"
+#include "utils/Simd.h"
 
 namespace parser {
 double const DEFAULT_DELTA = 0.00001;
@@ -46,10 +57,34 @@ options parse(int argc, char* argv[]) {
             ("start,s", po::value<double>(&opts.start)->default_value(0),"sets the recording start point for the simulation")
             ("end,e", po::value<double>(&opts.end)->default_value(DEFAULT_END),"set end point")
             ("file,F",po::value<std::vector<std::string>>(&opts.filepath)->multitoken(),"set the path to the file(s) containing initial state of the molecules")
-            ("outformat,O",po::value<std::string>()->default_value("vtk"),"set the output method (vtk,xyz)")
+            ("outformat,O",po::value<std::string>()->default_value("vtk"),"set the output method (vtk,vtkbin,xyz)")
+            ("vtkencoding",po::value<std::string>()->default_value("raw"),"set the encoding of the binary vtk output (raw,base64)")
+            ("vtkcompress","compress the binary vtk output with zlib")
             ("outfile,o",po::value<std::string>(&opts.outfile)->default_value("simulation"),"set the output file name")
+            ("checkpoint",po::value<int>(&opts.checkpointFrequency)->default_value(0),"write a checkpoint every n iterations and at the end, 0 disables them")
+            ("restart",po::value<std::string>(&opts.restart),"continue the simulation from a checkpoint, exclusive with file and cuboid")
+            ("outbuffers",po::value<int>(&opts.outputBuffers)->default_value(0),"write the output in a background thread with this many snapshot buffers, 0 writes synchronously")
+            ("timing",po::value<int>(&opts.timingFrequency)->default_value(0),"report the time of the simulation phases every n iterations, 0 only reports it at the end")
+            ("cutoff",po::value<double>(&opts.cutoff)->default_value(0),"set the cutoff radius and use linked cells, 0 calculates all pairs")
+            ("fused","fuse the velocity update with the position update of the next iteration into one sweep over the particles")
+            ("adaptive",po::value<double>(&opts.maxDisplacement)->default_value(0),"adapt the time step so no particle moves further than this distance in one step, --delta becomes the largest step, 0 uses the fixed --delta")
+            ("dtmin",po::value<double>(&opts.minStep)->default_value(0),"set the smallest step of the adaptive time stepping, 0 uses a millionth of --delta")
+            ("reorder",po::value<int>(&opts.reorderFrequency)->default_value(0),"sort the particles along a space-filling curve every n iterations, 0 never sorts them")
+            ("skin",po::value<double>(&opts.skin)->default_value(0),"set the skin of the Verlet lists and use them, requires a cutoff, 0 disables them")
+            ("domain",po::value<std::vector<double>>()->multitoken(),"set the size of the domain starting at the origin, fixes the linked cells to it, requires a cutoff")
+            ("boundary",po::value<std::vector<std::string>>()->multitoken(),"set the boundaries of the domain (none,periodic,reflect,outflow), either one for all faces or six in the order -x +x -y +y -z +z")
+            ("simd",po::value<std::string>()->default_value("auto"),"set the instruction set of the Lennard-Jones kernel (auto,scalar,avx2,avx512)")
             ("planet","sets particle mode to planet, exclusive with other particle modes")
-            ("lenjonesmol", po::value<std::vector<double>>()->multitoken(),"set particle mode to molecules using Lennard-Jones with epsilon and sigma as the following values, exclusive with other particle modes");
+            ("planetinterval",po::value<int>(&opts.slowInterval)->default_value(0),"add the gravity of --planet to the other force mode and evaluate it only every n iterations (r-RESPA), 0 makes planet an exclusive force mode")
+            ("theta",po::value<double>(&opts.theta)->default_value(0),"set the opening angle of the Barnes-Hut approximation for planets, 0 calculates all pairs directly")
+            ("ljtruncation",po::value<std::string>()->default_value("plain"),"set how the Lennard-Jones potential ends at the cutoff (plain,shifted,smooth), shifted and smooth require a cutoff and a single type")
+            ("ljswitch",po::value<double>()->default_value(0),"set the radius where the smooth Lennard-Jones potential starts to be switched off, has to be less than the cutoff")
+            ("tablefile",po::value<std::string>(),"set particle mode to a tabulated force read from a file of lines with a distance and the magnitude of the force, exclusive with other particle modes")
+            ("tabulate","replace the force by a table between --tableinner and the cutoff, requires a cutoff and a single type")
+            ("tableinner",po::value<double>()->default_value(0.5),"set the smallest distance of the table, closer pairs get the force at this distance")
+            ("tableintervals",po::value<int>()->default_value(4096),"set the amount of intervals of the table")
+            ("interpolation",po::value<std::string>()->default_value("cubic"),"set the interpolation between the points of the table (linear,cubic)")
+            ("lenjonesmol", po::value<std::vector<double>>()->multitoken(),"set particle mode to molecules using Lennard-Jones with epsilon and sigma as the following values, exclusive with other particle modes. Several pairs give the parameters of the types 0, 1, ... which are mixed with the Lorentz-Berthelot rules");
         // clang-format on
 
         po::variables_map vm;
@@ -63,21 +98,110 @@ options parse(int argc, char* argv[]) {
         }
 
         opts.executeTests = (vm.count("test"));
+        opts.fused = vm.count("fused") != 0;
 
         if (opts.executeTests) return opts;
 
+        // the tables are only built once the force mode is known
+        Interpolation interpolation = Interpolation::cubic;
+        if (vm["interpolation"].as<std::string>() == "linear") {
+            interpolation = Interpolation::linear;
+        } else if (vm["interpolation"].as<std::string>() != "cubic") {
+            std::cerr << vm["interpolation"].as<std::string>()
+                      << " is not a valid interpolation" << std::endl;
+            exit(1);
+        }
+        const int tableIntervals = vm["tableintervals"].as<int>();
+        if (tableIntervals <= 0) {
+            std::cerr << "A table needs at least one interval" << std::endl;
+            exit(1);
+        }
+
         // check exclusivity and existence of force modes
         std::vector<double> ljm_args;
-        if (vm.count("planet") && vm.count("lenjonesmol")) {
+        if (opts.slowInterval < 0) {
+            std::cerr << "The planet interval must not be negative"
+                      << std::endl;
+            exit(1);
+        }
+        // a planet with an interval is added to the other force mode
+        const bool slowPlanet = opts.slowInterval > 0;
+        if (slowPlanet && !vm.count("planet")) {
+            std::cerr << "The planet interval requires the planet mode"
+                      << std::endl;
+            exit(1);
+        }
+        if (slowPlanet) {
+            opts.slowForce_ = std::shared_ptr<Force>(new Planet(opts.theta));
+        }
+        if ((vm.count("planet") && !slowPlanet) + vm.count("lenjonesmol") +
+                vm.count("tablefile") >
+            1) {
             std::cerr << "Please choose EXACTLY ONE force mode" << std::endl;
             exit(1);
-        } else if (vm.count("planet")) {
-            opts.force_ = std::shared_ptr<Force>(new Planet());
+        } else if (vm.count("tablefile")) {
+            opts.force_ = std::shared_ptr<Force>(
+                new TabulatedForce(TabulatedForce::fromFile(
+                    vm["tablefile"].as<std::string>(), tableIntervals,
+                    interpolation)));
+        } else if (vm.count("planet") && !slowPlanet) {
+            opts.force_ = std::shared_ptr<Force>(new Planet(opts.theta));
         } else if (!vm["lenjonesmol"].empty() &&
                    (ljm_args = vm["lenjonesmol"].as<std::vector<double>>())
                            .size() == 2) {
+            const std::string truncation =
+                vm["ljtruncation"].as<std::string>();
+            if (truncation != "plain" && opts.cutoff <= 0) {
+                std::cerr << "The " << truncation
+                          << " Lennard-Jones potential requires a cutoff"
+                          << std::endl;
+                exit(1);
+            }
+            if (truncation == "plain") {
+                opts.force_ = std::shared_ptr<Force>(
+                    new LennardJonesMolecule(ljm_args[0], ljm_args[1]));
+            } else if (truncation == "shifted") {
+                opts.force_ = std::shared_ptr<Force>(new LennardJonesShifted(
+                    ljm_args[0], ljm_args[1], opts.cutoff));
+            } else if (truncation == "smooth") {
+                const double inner = vm["ljswitch"].as<double>();
+                if (inner <= 0 || inner >= opts.cutoff) {
+                    std::cerr << "The switching radius of the smooth "
+                                 "Lennard-Jones potential has to be between 0 "
+                                 "and the cutoff"
+                              << std::endl;
+                    exit(1);
+                }
+                opts.force_ = std::shared_ptr<Force>(new LennardJonesSmooth(
+                    ljm_args[0], ljm_args[1], inner, opts.cutoff));
+            } else {
+                std::cerr << truncation
+                          << " is not a valid Lennard-Jones truncation"
+                          << std::endl;
+                exit(1);
+            }
+        } else if (!ljm_args.empty()) {
+            if (vm["ljtruncation"].as<std::string>() != "plain") {
+                std::cerr << "Mixtures only support the plain Lennard-Jones "
+                             "truncation"
+                          << std::endl;
+                exit(1);
+            }
+            // one pair of epsilon and sigma per type
+            if (ljm_args.size() % 2 != 0) {
+                std::cerr << "Please provide an epsilon and a sigma for "
+                             "every type of molecule"
+                          << std::endl;
+                exit(1);
+            }
+            std::vector<double> epsilons;
+            std::vector<double> sigmas;
+            for (std::size_t k = 0; k < ljm_args.size(); k += 2) {
+                epsilons.push_back(ljm_args[k]);
+                sigmas.push_back(ljm_args[k + 1]);
+            }
             opts.force_ = std::shared_ptr<Force>(
-                new LennardJonesMolecule(ljm_args[0], ljm_args[1]));
+                new LennardJonesMixture(epsilons, sigmas));
         } else {
             std::cerr << "Please provide a single force mode" << std::endl;
             exit(1);
@@ -86,25 +210,220 @@ options parse(int argc, char* argv[]) {
         if (vm["outformat"].as<std::string>() == "vtk") {
             opts.writer_ =
                 std::shared_ptr<Writer>(new outputWriter::VTKWriter());
+        } else if (vm["outformat"].as<std::string>() == "vtkbin") {
+            outputWriter::VTKBinaryWriter::Encoding encoding;
+            if (vm["vtkencoding"].as<std::string>() == "raw") {
+                encoding = outputWriter::VTKBinaryWriter::Encoding::raw;
+            } else if (vm["vtkencoding"].as<std::string>() == "base64") {
+                encoding = outputWriter::VTKBinaryWriter::Encoding::base64;
+            } else {
+                std::cerr << vm["vtkencoding"].as<std::string>()
+                          << " is not a valid vtk encoding" << std::endl;
+                exit(1);
+            }
+            if (vm.count("vtkcompress") &&
+                !outputWriter::VTKBinaryWriter::compressionAvailable()) {
+                std::cerr << "MolSim was built without zlib, the output can "
+                             "not be compressed"
+                          << std::endl;
+                exit(1);
+            }
+            opts.writer_ =
+                std::shared_ptr<Writer>(new outputWriter::VTKBinaryWriter(
+                    encoding, vm.count("vtkcompress") != 0));
         } else if (vm["outformat"].as<std::string>() == "xyz") {
             opts.writer_ =
                 std::shared_ptr<Writer>(new outputWriter::XYZWriter());
         } else {
-            std::cerr << vm["output"].as<std::string>()
+            std::cerr << vm["outformat"].as<std::string>()
                       << " is not a valid output type" << std::endl;
             exit(1);
         }
 
+        if (opts.checkpointFrequency < 0) {
+            std::cerr << "The checkpoint frequency must not be negative"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (opts.fused && opts.slowForce_) {
+            std::cerr << "The fused mode can not be combined with a planet "
+                         "interval"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (opts.maxDisplacement < 0 || opts.minStep < 0) {
+            std::cerr << "The adaptive displacement and the smallest step "
+                         "must not be negative"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (opts.maxDisplacement > 0 && (opts.fused || opts.slowForce_)) {
+            std::cerr << "The adaptive time stepping can not be combined "
+                         "with the fused mode or a planet interval"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (opts.reorderFrequency < 0) {
+            std::cerr << "The reorder frequency must not be negative"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (!opts.restart.empty() &&
+            (vm.count("file") || vm.count("cuboid"))) {
+            std::cerr << "A restart can not be combined with files or cuboids"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (opts.outputBuffers < 0) {
+            std::cerr << "The amount of output buffers must not be negative"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (opts.outputBuffers > 0) {
+            opts.writer_ = std::shared_ptr<Writer>(
+                new outputWriter::AsyncWriter(opts.writer_, opts.outputBuffers));
+        }
+
+        if (opts.timingFrequency < 0) {
+            std::cerr << "The timing frequency must not be negative"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (opts.cutoff < 0) {
+            std::cerr << "The cutoff radius must not be negative" << std::endl;
+            exit(1);
+        }
+
+        if (opts.skin < 0 || (opts.skin > 0 && opts.cutoff == 0)) {
+            std::cerr << "The skin must not be negative and requires a cutoff"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (vm.count("domain")) {
+            std::vector<double> size = vm["domain"].as<std::vector<double>>();
+            if (size.size() != 3 || size[0] <= 0 || size[1] <= 0 ||
+                size[2] <= 0) {
+                std::cerr << "The domain requires three positive side lengths"
+                          << std::endl;
+                exit(1);
+            }
+            if (opts.cutoff == 0) {
+                std::cerr << "The domain requires a cutoff" << std::endl;
+                exit(1);
+            }
+            opts.domain.size = {size[0], size[1], size[2]};
+        }
+
+        if (vm.count("boundary")) {
+            std::vector<std::string> names =
+                vm["boundary"].as<std::vector<std::string>>();
+            if (names.size() != 1 && names.size() != 6) {
+                std::cerr << "Please provide one boundary for all faces or six "
+                             "boundaries"
+                          << std::endl;
+                exit(1);
+            }
+            if (!opts.domain.isBounded()) {
+                std::cerr << "The boundaries require a domain" << std::endl;
+                exit(1);
+            }
+            for (std::size_t face = 0; face < 6; face++) {
+                const std::string& name = names[names.size() == 1 ? 0 : face];
+                if (!boundary::parse(name, opts.domain.boundaries[face])) {
+                    std::cerr << name << " is not a valid boundary"
+                              << std::endl;
+                    exit(1);
+                }
+            }
+            for (int d = 0; d < 3; d++) {
+                if ((opts.domain.boundaries[2 * d] == Boundary::periodic) !=
+                    (opts.domain.boundaries[2 * d + 1] == Boundary::periodic)) {
+                    std::cerr << "Periodic boundaries have to be set on both "
+                                 "opposite faces"
+                              << std::endl;
+                    exit(1);
+                }
+                // otherwise a particle could interact with two images of
+                // another one
+                if (opts.domain.isPeriodic(d) &&
+                    opts.domain.size[d] < 2 * (opts.cutoff + opts.skin)) {
+                    std::cerr << "A periodic domain has to be at least twice "
+                                 "as large as the cutoff plus the skin"
+                              << std::endl;
+                    exit(1);
+                }
+            }
+        }
+
+        if (opts.theta < 0 || (opts.theta > 0 && !vm.count("planet"))) {
+            std::cerr << "The opening angle must not be negative and requires "
+                         "the planet mode"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (opts.theta > 0 && opts.cutoff > 0 && !opts.slowForce_) {
+            std::cerr << "The Barnes-Hut approximation can not be combined "
+                         "with a cutoff"
+                      << std::endl;
+            exit(1);
+        }
+
+        if (vm.count("tabulate")) {
+            const double inner = vm["tableinner"].as<double>();
+            if (opts.cutoff <= 0 || inner <= 0 || inner >= opts.cutoff) {
+                std::cerr << "Tabulating the force requires a cutoff and an "
+                             "inner radius between 0 and the cutoff"
+                          << std::endl;
+                exit(1);
+            }
+            const auto* central =
+                dynamic_cast<const CentralForce*>(opts.force_.get());
+            if (vm.count("tablefile") || opts.theta > 0 || !central ||
+                dynamic_cast<LennardJonesMixture*>(opts.force_.get())) {
+                std::cerr << "Only single forces between all pairs can be "
+                             "tabulated"
+                          << std::endl;
+                exit(1);
+            }
+            // gravity is proportional to the masses, which are not tabulated
+            opts.force_ = std::shared_ptr<Force>(new TabulatedForce(
+                *central, inner, opts.cutoff, tableIntervals,
+                interpolation, vm.count("planet") && !opts.slowForce_));
+        }
+
+        if (!simd::parse(vm["simd"].as<std::string>(), opts.simd)) {
+            std::cerr << vm["simd"].as<std::string>()
+                      << " is not a valid instruction set" << std::endl;
+            exit(1);
+        }
+
+        if (!simd::isSupported(opts.simd)) {
+            std::cerr << "The CPU does not support "
+                      << simd::toString(opts.simd) << std::endl;
+            exit(1);
+        }
+
         // parse cuboid options
         if (vm.count("cuboid") != 0) {
             parseCuboids(vm["cuboid"].as<std::string>(), opts.cuboids);
         }
 
         // check if we got passed any particles
-        if (opts.cuboids.empty() && opts.filepath.empty()) {
+        if (opts.cuboids.empty() && opts.filepath.empty() &&
+            opts.restart.empty()) {
             spdlog::get("console")->critical(
                 "There are no particles to run the simulation on. Please "
-                "include at least 2 particles via file or cuboid.");
+                "include at least 2 particles via file, cuboid or restart.");
             exit(1);
         }
 
@@ -138,6 +457,7 @@ enum class cuboid_parser_state {
     y,
     z,
     avgBrownMot,
+    type,
     end,
     trap
 };
@@ -178,6 +498,8 @@ std::string parser_state_tostring(cuboid_parser_state state) {
             return "z";
         case cuboid_parser_state::avgBrownMot:
             return "avgBrownMot";
+        case cuboid_parser_state::type:
+            return "type";
         case cuboid_parser_state::end:
             return "end";
         case cuboid_parser_state::trap:
@@ -202,15 +524,19 @@ void parseCuboids(std::string cuboid_s, std::vector<CuboidGenerator>& ret) {
     int xc;
     int yc;
     int zc;
+    int type = 0;
 
     for (int i = 0; i < cuboid_s.length() && state != cuboid_parser_state::trap;
          i++) {
         char currentChar = cuboid_s.at(i);
-        spdlog::get("file")->debug(parser_state_tostring(state) + " -> " +
-                                   currentChar +
-                                   " \n    Cached chars are: " + currentString);
+        SPDLOG_LOGGER_DEBUG(logging::file(),
+                            "{} -> {} \n    Cached chars are: {}",
+                            parser_state_tostring(state), currentChar,
+                            currentString);
         switch (state) {
             case cuboid_parser_state::start:
+                // the type is optional
+                type = 0;
                 if (currentChar == '[')
                     state = cuboid_parser_state::V_B;
                 else
@@ -369,6 +695,21 @@ void parseCuboids(std::string cuboid_s, std::vector<CuboidGenerator>& ret) {
                     aBM = stod(currentString);
                     state = cuboid_parser_state::end;
                     currentString = "";
+                } else if (currentChar == ',') {
+                    aBM = stod(currentString);
+                    state = cuboid_parser_state::type;
+                    currentString = "";
+                } else
+                    state = cuboid_parser_state::trap;
+                break;
+            case cuboid_parser_state::type:
+                // is 0-9
+                if (currentChar <= 57 && currentChar >= 48)
+                    currentString += currentChar;
+                else if (currentChar == ']') {
+                    type = stoi(currentString);
+                    state = cuboid_parser_state::end;
+                    currentString = "";
                 } else
                     state = cuboid_parser_state::trap;
                 break;
@@ -388,11 +729,13 @@ void parseCuboids(std::string cuboid_s, std::vector<CuboidGenerator>& ret) {
                 << "    dist: " << d << "\n"
                 << "    mass: " << m << "\n"
                 << "    Brownian motion: " << aBM << "\n"
+                << "    type: " << type << "\n"
                 << "    corner:" << llfc << "\n"
                 << "    velocity: " << velo;
                 // clang-format on
                 spdlog::get("file")->debug(ss.str());
-                ret.emplace_back(xc, yc, zc, d, m, aBM, llfc, velo);
+                ret.emplace_back(xc, yc, zc, d, m, aBM, llfc, velo,
+                         (std::uint32_t)ret.size(), type);
                 if (currentChar == ',')
                     state = cuboid_parser_state::start;
                 else
@@ -417,12 +760,14 @@ void parseCuboids(std::string cuboid_s, std::vector<CuboidGenerator>& ret) {
            << "    dist: " << d << "\n"
            << "    mass: " << m << "\n"
            << "    Brownian motion: " << aBM << "\n"
+           << "    type: " << type << "\n"
            << "    corner:" << llfc << "\n"
            << "    velocity: " << velo;
         // clang-format on
 
         spdlog::get("file")->debug(ss.str());
-        ret.emplace_back(xc, yc, zc, d, m, aBM, llfc, velo);
+        ret.emplace_back(xc, yc, zc, d, m, aBM, llfc, velo,
+                         (std::uint32_t)ret.size(), type);
     }
 }
 
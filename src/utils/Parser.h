@@ -4,9 +4,11 @@
 #include <string>
 #include <vector>
 
+#include "container/Domain.h"
 #include "force/Force.h"
 #include "input/CuboidGenerator.h"
 #include "outputWriter/Writer.h"
+#include "utils/Simd.h"
 
 namespace parser {
 
@@ -16,11 +18,26 @@ struct options {
     double start{};
     double end{};
     int writeoutFrequency{};
+    int outputBuffers{};
+    int timingFrequency{};
+    int checkpointFrequency{};
+    int reorderFrequency{};
+    bool fused = false;
+    double maxDisplacement{};
+    double minStep{};
+    double cutoff{};
+    double skin{};
+    double theta{};
+    Domain domain;
+    SimdLevel simd = SimdLevel::scalar;
     std::vector<std::string> filepath;
     std::vector<CuboidGenerator> cuboids;
     std::string outfile;
+    std::string restart;
     std::shared_ptr<Writer> writer_;
     std::shared_ptr<Force> force_;
+    std::shared_ptr<Force> slowForce_;
+    int slowInterval{};
 };
 
 // predeclaration
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * \brief
+ *  The counter-based random number generator Philox4x32-10 (Salmon et al.,
+ *  "Parallel random numbers: as easy as 1, 2, 3", 2011).
+ *
+ *  Every random number is a pure function of a key and a counter, so
+ *  particles can draw their numbers in any order and on any thread and still
+ *  get the same ones.
+ */
+namespace philox {
+
+using Counter = std::array<std::uint32_t, 4>;
+using Key = std::array<std::uint32_t, 2>;
+
+namespace detail {
+constexpr std::uint32_t M0 = 0xD2511F53;
+constexpr std::uint32_t M1 = 0xCD9E8D57;
+constexpr std::uint32_t W0 = 0x9E3779B9;
+constexpr std::uint32_t W1 = 0xBB67AE85;
+constexpr double PI = 3.14159265358979323846;
+
+inline void round(Counter& c, const Key& k) {
+    const std::uint64_t p0 = (std::uint64_t)M0 * c[0];
+    const std::uint64_t p1 = (std::uint64_t)M1 * c[2];
+    c = {(std::uint32_t)(p1 >> 32) ^ c[1] ^ k[0], (std::uint32_t)p1,
+         (std::uint32_t)(p0 >> 32) ^ c[3] ^ k[1], (std::uint32_t)p0};
+}
+}  // namespace detail
+
+/**
+ * \brief
+ *  Returns the four random 32 bit words for the counter and key
+ */
+inline Counter philox4x32(Counter counter, Key key) {
+    for (int r = 0; r < 10; r++) {
+        if (r > 0) {
+            key[0] += detail::W0;
+            key[1] += detail::W1;
+        }
+        detail::round(counter, key);
+    }
+    return counter;
+}
+
+/**
+ * \brief
+ *  Converts 64 random bits to a double uniformly distributed in (0, 1]
+ */
+inline double toUniform(std::uint32_t high, std::uint32_t low) {
+    const std::uint64_t bits = ((std::uint64_t)high << 32) | low;
+    return (double)((bits >> 11) + 1) * 0x1.0p-53;
+}
+
+/**
+ * \brief
+ *  Returns two independent standard normally distributed numbers for the
+ *  counter and key, using the Box-Muller transform
+ */
+inline std::array<double, 2> normal2(const Counter& counter, const Key& key) {
+    const Counter r = philox4x32(counter, key);
+    const double radius = std::sqrt(-2. * std::log(toUniform(r[0], r[1])));
+    const double angle = 2. * detail::PI * toUniform(r[2], r[3]);
+    return {radius * std::cos(angle), radius * std::sin(angle)};
+}
+
+}  // namespace philox
@@ -0,0 +1,55 @@
+#include "Simd.h"
+
+namespace simd {
+
+bool isSupported(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::scalar:
+            return true;
+        case SimdLevel::avx2:
+            return __builtin_cpu_supports("avx2") &&
+                   __builtin_cpu_supports("fma");
+        case SimdLevel::avx512:
+            return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+}
+
+SimdLevel detect() {
+    if (isSupported(SimdLevel::avx512)) {
+        return SimdLevel::avx512;
+    }
+    if (isSupported(SimdLevel::avx2)) {
+        return SimdLevel::avx2;
+    }
+    return SimdLevel::scalar;
+}
+
+bool parse(const std::string& name, SimdLevel& level) {
+    if (name == "auto") {
+        level = detect();
+    } else if (name == "scalar") {
+        level = SimdLevel::scalar;
+    } else if (name == "avx2") {
+        level = SimdLevel::avx2;
+    } else if (name == "avx512") {
+        level = SimdLevel::avx512;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string toString(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::scalar:
+            return "scalar";
+        case SimdLevel::avx2:
+            return "avx2";
+        case SimdLevel::avx512:
+            return "avx512";
+    }
+    return "NOT A LEVEL";
+}
+
+}  // namespace simd
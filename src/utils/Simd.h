@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+
+/**
+ * \brief
+ *  The vector instruction sets the force kernels are available for
+ */
+enum class SimdLevel {
+    /** Plain C++, works on every CPU */
+    scalar,
+    /** 4 doubles per instruction */
+    avx2,
+    /** 8 doubles per instruction */
+    avx512
+};
+
+namespace simd {
+
+/**
+ * \brief
+ *  Detects the widest instruction set supported by the executing CPU
+ * \return
+ *  The best supported SimdLevel
+ */
+SimdLevel detect();
+
+/**
+ * \brief
+ *  Checks if the executing CPU supports the given instruction set
+ * \param level
+ *  The instruction set to check
+ * \return
+ *  True if the kernels for this level can be executed
+ */
+bool isSupported(SimdLevel level);
+
+/**
+ * \brief
+ *  Parses the name of an instruction set
+ * \param name
+ *  One of "auto", "scalar", "avx2" or "avx512".
+ *  "auto" is resolved with detect().
+ * \param level
+ *  The parsed level, only written on success
+ * \return
+ *  True if name was valid
+ */
+bool parse(const std::string& name, SimdLevel& level);
+
+/**
+ * \brief
+ *  Returns the name of the instruction set
+ */
+std::string toString(SimdLevel level);
+
+}  // namespace simd
@@ -0,0 +1,40 @@
+#pragma once
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * \brief
+ *  Thin wrappers around the OpenMP runtime, so the code also compiles
+ *  without OpenMP. Then everything runs on a single thread.
+ */
+namespace threads {
+
+/**
+ * \brief
+ *  Returns the amount of threads a parallel region will use.
+ *  Can be set with the environment variable OMP_NUM_THREADS.
+ */
+inline int count() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/**
+ * \brief
+ *  Returns the index of the calling thread in the current parallel region,
+ *  0 outside of parallel regions
+ */
+inline int index() {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+}  // namespace threads
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <list>
+#include <vector>
+
+#include "container/Domain.h"
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/LennardJonesMolecule.h"
+#include "simulation/StoermerVerlet.h"
+
+class BoundariesTest : public testing::Test {
+   protected:
+    BoundariesTest() {
+        // every particle moves in another direction, the mass identifies it
+        for (int x = 0; x < 5; x++) {
+            for (int y = 0; y < 5; y++) {
+                for (int z = 0; z < 5; z++) {
+                    std::array<double, 3> pos = {1 + x * 2., 1 + y * 2.,
+                                                 1 + z * 2.};
+                    std::array<double, 3> v = {3. * (x - 2), 2. * (y - 2),
+                                               1. * (z - 2)};
+                    init.emplace_back(pos, v, 1 + 0.01 * (double)init.size(),
+                                      (int)init.size());
+                }
+            }
+        }
+        domain.size = {10, 10, 10};
+    }
+
+    /**
+     * Moves the particles without any forces and applies the boundaries
+     */
+    static void move(ParticleContainer& pc, int steps) {
+        for (int step = 0; step < steps; step++) {
+            calculateX(pc, 0.01, 0.0001);
+            pc.applyBoundaries();
+        }
+    }
+
+    std::list<Particle> init;
+    Domain domain;
+};
+
+TEST_F(BoundariesTest, removeParticlesKeepsOrder) {
+    ParticleContainer pc(init.size(), init);
+    std::vector<char> remove(pc.size(), 0);
+    for (std::size_t i = 0; i < pc.size(); i += 3) {
+        remove[i] = 1;
+    }
+
+    ASSERT_EQ(42, pc.removeParticles(remove));
+    ASSERT_EQ(83, pc.size());
+    std::size_t i = 0;
+    int original = 0;
+    for (const Particle& p : init) {
+        if (original++ % 3 == 0) {
+            continue;
+        }
+        ASSERT_EQ(p.getX(), pc[i].getX());
+        ASSERT_EQ(p.getV(), pc[i].getV());
+        ASSERT_EQ(p.getM(), pc.mass()[i]);
+        ASSERT_EQ(p.getType(), pc.type()[i]);
+        i++;
+    }
+}
+
+TEST_F(BoundariesTest, removalKeepsNeighbours) {
+    LennardJonesMolecule lj(5, 1);
+    Domain periodic = domain;
+    periodic.boundaries.fill(Boundary::periodic);
+
+    for (const Domain& d : {Domain{}, periodic}) {
+        for (double skin : {0., 0.5}) {
+            ParticleContainer pc(init.size(), init, 2.5, skin, d);
+            calculateF(pc, lj);
+
+            std::vector<char> remove(pc.size(), 0);
+            for (std::size_t i = 0; i < pc.size(); i += 2) {
+                remove[i] = 1;
+            }
+            pc.removeParticles(remove);
+            calculateF(pc, lj);
+            // the Verlet lists are renumbered instead of rebuilt
+            ASSERT_EQ(skin > 0 ? 1 : 0, pc.getRebuildCount());
+
+            // a new container with the same particles
+            std::list<Particle> remaining;
+            for (auto p : pc) {
+                remaining.emplace_back(p.getX(), p.getV(), p.getM(),
+                                       p.getType());
+            }
+            ParticleContainer fresh(remaining.size(), remaining, 2.5, skin, d);
+            calculateF(fresh, lj);
+
+            for (std::size_t i = 0; i < pc.size(); i++) {
+                for (int k = 0; k < 3; k++) {
+                    ASSERT_NEAR(fresh.force(k)[i], pc.force(k)[i],
+                                1e-12 * (1 + std::abs(fresh.force(k)[i])));
+                }
+            }
+        }
+    }
+}
+
+TEST_F(BoundariesTest, outflowRemovesLeavingParticles) {
+    domain.boundaries.fill(Boundary::outflow);
+    ParticleContainer pc(init.size(), init, 2.5, 0, domain);
+
+    move(pc, 100);
+    // only the particles at rest in x remain
+    ASSERT_LT(pc.size(), init.size());
+    ASSERT_GT(pc.size(), 0);
+    for (std::size_t i = 0; i < pc.size(); i++) {
+        for (int d = 0; d < 3; d++) {
+            ASSERT_GE(pc.position(d)[i], 0);
+            ASSERT_LE(pc.position(d)[i], 10);
+        }
+        // the survivors keep their order
+        if (i > 0) {
+            ASSERT_LT(pc.type()[i - 1], pc.type()[i]);
+        }
+    }
+
+    move(pc, 1000);
+    ASSERT_EQ(1, pc.size());
+    ASSERT_EQ(0, pc.velocity(0)[0]);
+}
+
+TEST_F(BoundariesTest, reflectKeepsParticlesInside) {
+    domain.boundaries.fill(Boundary::reflect);
+    ParticleContainer pc(init.size(), init, 2.5, 0, domain);
+
+    move(pc, 500);
+    ASSERT_EQ(init.size(), pc.size());
+    std::size_t i = 0;
+    for (const Particle& p : init) {
+        for (int d = 0; d < 3; d++) {
+            ASSERT_GE(pc.position(d)[i], 0);
+            ASSERT_LE(pc.position(d)[i], 10);
+            // only the direction changes
+            ASSERT_EQ(std::abs(p.getV()[d]), std::abs(pc.velocity(d)[i]));
+        }
+        i++;
+    }
+}
+
+TEST_F(BoundariesTest, mixedBoundaries) {
+    // periodic in x, reflecting in y and outflow in z
+    domain.boundaries = {Boundary::periodic, Boundary::periodic,
+                         Boundary::reflect,  Boundary::reflect,
+                         Boundary::outflow,  Boundary::outflow};
+    ParticleContainer pc(init.size(), init, 2.5, 0.3, domain);
+    LennardJonesMolecule lj(1, 1);
+
+    for (int step = 0; step < 300; step++) {
+        calculateX(pc, 0.01, 0.0001);
+        pc.applyBoundaries();
+        calculateF(pc, lj);
+        calculateV(pc, 0.01);
+    }
+
+    // the particles moving in z left, the others are still there
+    ASSERT_LT(pc.size(), init.size());
+    for (std::size_t i = 0; i < pc.size(); i++) {
+        ASSERT_GE(pc.position(1)[i], 0);
+        ASSERT_LE(pc.position(1)[i], 10);
+        ASSERT_GE(pc.position(2)[i], 0);
+        ASSERT_LE(pc.position(2)[i], 10);
+    }
+}
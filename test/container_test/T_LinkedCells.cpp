@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <list>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "utils/ArrayUtils.h"
+
+class LinkedCellsTest : public testing::Test {
+   protected:
+    LinkedCellsTest() {
+        // slightly irregular lattice, so distances are not all identical
+        for (int x = 0; x < 6; x++) {
+            for (int y = 0; y < 5; y++) {
+                for (int z = 0; z < 4; z++) {
+                    std::array<double, 3> pos = {x * 1.1 + 0.05 * (y % 2),
+                                                 y * 0.9 + 0.03 * (z % 3),
+                                                 z * 1.3 + 0.07 * (x % 2)};
+                    init.emplace_back(pos, v, 1, 0);
+                }
+            }
+        }
+    }
+
+    /**
+     * Counts all pairs closer than the cutoff by brute force
+     */
+    std::size_t countPairs(double cutoff) {
+        std::size_t count = 0;
+        for (auto p1 = init.begin(); p1 != init.end(); p1++) {
+            for (auto p2 = std::next(p1); p2 != init.end(); p2++) {
+                if (ArrayUtils::L2Norm(p1->getX() - p2->getX()) <= cutoff) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    std::array<double, 3> v = {0, 0, 0};
+    std::list<Particle> init;
+};
+
+TEST_F(LinkedCellsTest, findsAllPairsInsideCutoff) {
+    for (double cutoff : {0.95, 1.5, 2.5, 4.0}) {
+        ParticleContainer pc(init.size(), init, cutoff);
+
+        std::size_t count = 0;
+        pc.forEachPair([&count](std::size_t, std::size_t) { count++; });
+
+        ASSERT_EQ(countPairs(cutoff), count) << "cutoff: " << cutoff;
+    }
+}
+
+TEST_F(LinkedCellsTest, noCutoffVisitsAllPairs) {
+    ParticleContainer pc(init.size(), init);
+
+    std::size_t count = 0;
+    pc.forEachPair([&count](std::size_t, std::size_t) { count++; });
+
+    ASSERT_EQ(init.size() * (init.size() - 1) / 2, count);
+}
+
+TEST_F(LinkedCellsTest, everyPairOnlyOnce) {
+    ParticleContainer pc(init.size(), init, 2.);
+
+    std::size_t count = 0;
+    pc.forEachPair([&count](std::size_t i, std::size_t j) {
+        ASSERT_NE(i, j);
+        count++;
+    });
+
+    // a huge cutoff has to result in every pair being visited once
+    ParticleContainer all(init.size(), init, 100.);
+    std::size_t allCount = 0;
+    all.forEachPair([&allCount](std::size_t, std::size_t) { allCount++; });
+
+    ASSERT_EQ(countPairs(2.), count);
+    ASSERT_EQ(init.size() * (init.size() - 1) / 2, allCount);
+}
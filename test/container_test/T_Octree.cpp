@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <list>
+#include <vector>
+
+#include "container/Octree.h"
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/Planet.h"
+#include "simulation/StoermerVerlet.h"
+
+class OctreeTest : public testing::Test {
+   protected:
+    OctreeTest() {
+        // two clusters, so the tree has to approximate far away groups
+        for (int k = 0; k < 600; k++) {
+            double offset = k % 2 == 0 ? 0 : 40;
+            std::array<double, 3> pos = {
+                offset + std::fmod(k * 0.618, 7.),
+                std::fmod(k * 0.414, 5.) - 0.5 * offset,
+                std::fmod(k * 0.732, 6.)};
+            init.emplace_back(pos, v, 1. + (k % 3), 0);
+        }
+    }
+
+    /**
+     * Calculates the forces of all pairs directly
+     */
+    std::vector<std::array<double, 3>> directForces() {
+        ParticleContainer pc(init.size(), init);
+        calculateF(pc, Planet());
+
+        std::vector<std::array<double, 3>> forces(pc.size());
+        for (std::size_t i = 0; i < pc.size(); i++) {
+            forces[i] = {pc.force(0)[i], pc.force(1)[i], pc.force(2)[i]};
+        }
+        return forces;
+    }
+
+    std::array<double, 3> v = {0, 0, 0};
+    std::list<Particle> init;
+};
+
+TEST_F(OctreeTest, containsEveryParticleOnce) {
+    ParticleContainer pc(init.size(), init);
+    const Octree& tree = pc.buildOctree();
+
+    std::vector<int> seen(pc.size(), 0);
+    for (std::size_t k = 0; k < pc.size(); k++) {
+        seen[tree.particleAt(k)]++;
+    }
+    for (int s : seen) {
+        ASSERT_EQ(1, s);
+    }
+    ASSERT_GT(tree.nodeCount(), pc.size() / 8);
+}
+
+TEST_F(OctreeTest, thetaZeroIsExact) {
+    std::vector<std::array<double, 3>> expected = directForces();
+
+    ParticleContainer pc(init.size(), init);
+    Planet planet(0);
+    const Octree& tree = pc.buildOctree();
+
+    for (std::size_t k = 0; k < pc.size(); k++) {
+        std::size_t i = tree.particleAt(k);
+        std::array<double, 3> f = tree.calculateForce(k, planet, 0);
+        for (int d = 0; d < 3; d++) {
+            ASSERT_NEAR(expected[i][d], f[d], 1e-9 * std::abs(expected[i][d]));
+        }
+    }
+}
+
+TEST_F(OctreeTest, approximatesDirectSum) {
+    std::vector<std::array<double, 3>> expected = directForces();
+
+    ParticleContainer pc(init.size(), init);
+    Planet planet(0.5);
+    selectForceFunction(planet)(pc, planet);
+
+    // the relative error of the total force stays small
+    double errorSq = 0;
+    double normSq = 0;
+    for (std::size_t i = 0; i < pc.size(); i++) {
+        for (int d = 0; d < 3; d++) {
+            double diff = pc.force(d)[i] - expected[i][d];
+            errorSq += diff * diff;
+            normSq += expected[i][d] * expected[i][d];
+        }
+    }
+    ASSERT_LT(std::sqrt(errorSq / normSq), 1e-2);
+}
+
+TEST_F(OctreeTest, emptyContainer) {
+    std::list<Particle> none;
+    ParticleContainer pc(0, none);
+
+    ASSERT_EQ(0, pc.buildOctree().nodeCount());
+}
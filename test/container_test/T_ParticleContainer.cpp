@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+
+class ParticleContainerTest : public testing::Test {
+   protected:
+    ParticleContainerTest() {
+        for (int i = 0; i < 10; i++) {
+            std::array<double, 3> x = {(double)i, 2. * i, 3. * i};
+            std::array<double, 3> v = {-1. * i, -2. * i, -3. * i};
+            init.emplace_back(x, v, 1. + i, i % 3);
+        }
+    }
+
+    std::list<Particle> init;
+};
+
+TEST_F(ParticleContainerTest, iteratesInInsertionOrder) {
+    ParticleContainer pc(init.size(), init);
+
+    ASSERT_EQ(init.size(), pc.size());
+
+    auto expected = init.begin();
+    for (auto p : pc) {
+        ASSERT_EQ(expected->getX(), p.getX());
+        ASSERT_EQ(expected->getV(), p.getV());
+        ASSERT_EQ(expected->getM(), p.getM());
+        ASSERT_EQ(expected->getType(), p.getType());
+        expected++;
+    }
+    ASSERT_EQ(init.end(), expected);
+}
+
+TEST_F(ParticleContainerTest, arraysAreAligned) {
+    ParticleContainer pc(init.size(), init);
+
+    for (int d = 0; d < 3; d++) {
+        ASSERT_EQ(0, (std::uintptr_t)pc.position(d) % 64);
+        ASSERT_EQ(0, (std::uintptr_t)pc.velocity(d) % 64);
+        ASSERT_EQ(0, (std::uintptr_t)pc.force(d) % 64);
+        ASSERT_EQ(0, (std::uintptr_t)pc.oldForce(d) % 64);
+    }
+    ASSERT_EQ(0, (std::uintptr_t)pc.mass() % 64);
+}
+
+TEST_F(ParticleContainerTest, referencesWriteThrough) {
+    ParticleContainer pc(init.size(), init);
+    std::array<double, 3> force = {1, 2, 3};
+
+    pc[4].addF(force);
+    (pc.begin() + 4)->addF(force);
+
+    ASSERT_EQ(2., pc.force(0)[4]);
+    ASSERT_EQ(4., pc.force(1)[4]);
+    ASSERT_EQ(6., pc.force(2)[4]);
+
+    pc.nextIteration();
+
+    std::array<double, 3> expectedOld = {2, 4, 6};
+    std::array<double, 3> expectedNew = {0, 0, 0};
+    ASSERT_EQ(expectedOld, pc[4].getOldF());
+    ASSERT_EQ(expectedNew, pc[4].getF());
+}
+
+TEST_F(ParticleContainerTest, parallelBlocksMatchSerial) {
+    std::list<Particle> cloud;
+    std::array<double, 3> v = {0, 0, 0};
+    for (int i = 0; i < 300; i++) {
+        std::array<double, 3> x = {(i % 7) * 0.9, ((i / 7) % 6) * 1.1,
+                                   (i / 42) * 1.3 + 0.01 * (i % 5)};
+        cloud.emplace_back(x, v, 1, 0);
+    }
+
+    // (cutoff, skin): all pairs, linked cells and Verlet lists
+    std::vector<std::pair<double, double>> modes = {{0, 0}, {2, 0}, {2, .5}};
+    for (auto [cutoff, skin] : modes) {
+        ParticleContainer pc(cloud.size(), cloud, cutoff, skin);
+
+        // the amount of candidates of every particle
+        std::vector<double> expected(pc.size(), 0);
+        pc.forEachNeighbourBlock(
+            [&](std::size_t i, const std::size_t* block, std::size_t count) {
+                expected[i] += count;
+                for (std::size_t k = 0; k < count; k++) {
+                    expected[block[k]]++;
+                }
+            });
+
+        pc.nextIteration();
+        pc.forEachNeighbourBlockParallel([](double* fx, double*, double*) {
+            return [fx](std::size_t i, const std::size_t* block,
+                        std::size_t count) {
+                fx[i] += count;
+                for (std::size_t k = 0; k < count; k++) {
+                    fx[block[k]]++;
+                }
+            };
+        });
+
+        for (std::size_t i = 0; i < pc.size(); i++) {
+            ASSERT_EQ(expected[i], pc.force(0)[i]);
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <list>
+#include <vector>
+
+#include "container/Domain.h"
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/LennardJonesMolecule.h"
+#include "simulation/StoermerVerlet.h"
+#include "utils/Simd.h"
+
+class PeriodicTest : public testing::Test {
+   protected:
+    PeriodicTest() {
+        // a jittered lattice filling the domain, some particles start
+        // slightly outside of it
+        for (int x = 0; x < 6; x++) {
+            for (int y = 0; y < 7; y++) {
+                for (int z = 0; z < 8; z++) {
+                    std::array<double, 3> pos = {
+                        x * 1.1 - 0.05 + 0.03 * ((y + z) % 4),
+                        y * 1.1 + 0.02 * ((x + 2 * z) % 5),
+                        z * 1.1 - 0.04 + 0.05 * ((x * y) % 3)};
+                    std::array<double, 3> v = {0.3 * ((x + z) % 3 - 1),
+                                               0.2 * ((y + x) % 3 - 1),
+                                               0.4 * ((z + y) % 3 - 1)};
+                    init.emplace_back(pos, v, 1, 0);
+                }
+            }
+        }
+        domain.size = {6.6, 7.7, 8.8};
+    }
+
+    /**
+     * Calculates the forces by brute force with the minimum image convention
+     * in the periodic dimensions
+     */
+    std::vector<std::array<double, 3>> expectedForces(ParticleContainer& pc) {
+        std::vector<std::array<double, 3>> f(pc.size(), {0, 0, 0});
+        for (std::size_t i = 0; i < pc.size(); i++) {
+            for (std::size_t j = i + 1; j < pc.size(); j++) {
+                std::array<double, 3> dx{};
+                double distanceSq = 0;
+                for (int d = 0; d < 3; d++) {
+                    dx[d] = pc.position(d)[i] - pc.position(d)[j];
+                    if (domain.isPeriodic(d)) {
+                        dx[d] -= domain.size[d] *
+                                 std::round(dx[d] / domain.size[d]);
+                    }
+                    distanceSq += dx[d] * dx[d];
+                }
+                if (distanceSq > cutoff * cutoff) {
+                    continue;
+                }
+                double s = lj.calculateScalar(distanceSq, 1, 1);
+                for (int d = 0; d < 3; d++) {
+                    f[i][d] += s * dx[d];
+                    f[j][d] -= s * dx[d];
+                }
+            }
+        }
+        return f;
+    }
+
+    std::list<Particle> init;
+    Domain domain;
+    LennardJonesMolecule lj{5, 1};
+    double cutoff = 2.5;
+};
+
+TEST_F(PeriodicTest, forcesMatchMinimumImage) {
+    const std::vector<std::array<Boundary, 6>> boundaries = {
+        {Boundary::periodic, Boundary::periodic, Boundary::periodic,
+         Boundary::periodic, Boundary::periodic, Boundary::periodic},
+        {Boundary::periodic, Boundary::periodic, Boundary::none,
+         Boundary::none, Boundary::none, Boundary::none}};
+
+    for (const auto& faces : boundaries) {
+        domain.boundaries = faces;
+        for (double skin : {0., 0.3}) {
+            for (SimdLevel level : {SimdLevel::scalar, simd::detect()}) {
+                ParticleContainer pc(init.size(), init, cutoff, skin, domain);
+                selectForceFunction(lj, level)(pc, lj);
+                auto expected = expectedForces(pc);
+
+                for (std::size_t i = 0; i < pc.size(); i++) {
+                    for (int d = 0; d < 3; d++) {
+                        ASSERT_NEAR(expected[i][d], pc.force(d)[i],
+                                    1e-9 * (1 + std::abs(expected[i][d])))
+                            << "particle " << i << ", skin " << skin;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(PeriodicTest, particlesAreWrapped) {
+    domain.boundaries.fill(Boundary::periodic);
+    ParticleContainer pc(init.size(), init, cutoff, 0, domain);
+
+    for (int step = 0; step < 50; step++) {
+        calculateX(pc, 0.01, 0.0001);
+        calculateF(pc, lj);
+        calculateV(pc, 0.01);
+        for (std::size_t i = 0; i < pc.size(); i++) {
+            for (int d = 0; d < 3; d++) {
+                ASSERT_GE(pc.position(d)[i], 0);
+                ASSERT_LE(pc.position(d)[i], domain.size[d]);
+            }
+        }
+    }
+}
+
+TEST_F(PeriodicTest, verletListsFollowTheParticles) {
+    domain.boundaries.fill(Boundary::periodic);
+    ParticleContainer cells(init.size(), init, cutoff, 0, domain);
+    ParticleContainer verlet(init.size(), init, cutoff, 0.4, domain);
+
+    for (int step = 0; step < 50; step++) {
+        for (ParticleContainer* pc : {&cells, &verlet}) {
+            calculateX(*pc, 0.002, 0.000004);
+            calculateF(*pc, lj);
+            calculateV(*pc, 0.002);
+        }
+    }
+    ASSERT_LT(verlet.getRebuildCount(), 50);
+
+    // the Verlet lists only wrap on a rebuild
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        for (int d = 0; d < 3; d++) {
+            double dx = cells.position(d)[i] - verlet.position(d)[i];
+            dx -= domain.size[d] * std::round(dx / domain.size[d]);
+            ASSERT_NEAR(0, dx, 1e-8);
+            ASSERT_NEAR(cells.velocity(d)[i], verlet.velocity(d)[i], 1e-8);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "container/Domain.h"
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/LennardJonesMolecule.h"
+#include "simulation/StoermerVerlet.h"
+
+class ReorderTest : public testing::Test {
+   protected:
+    ReorderTest() {
+        // a jittered lattice in a random order, the type identifies the
+        // particle
+        std::vector<int> order(7 * 6 * 5);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+        for (const int i : order) {
+            const int x = i % 7;
+            const int y = i / 7 % 6;
+            const int z = i / 42;
+            std::array<double, 3> pos = {x * 1.1 + 0.03 * ((y + z) % 4),
+                                         y * 1.1 + 0.02 * ((x + 2 * z) % 5),
+                                         z * 1.1 + 0.05 * ((x * y) % 3)};
+            std::array<double, 3> v = {0.3 * ((x + z) % 3 - 1),
+                                       0.2 * ((y + x) % 3 - 1),
+                                       0.4 * ((z + y) % 3 - 1)};
+            init.emplace_back(pos, v, 1 + 0.001 * i, i);
+        }
+        domain.size = {7.7, 6.6, 5.5};
+    }
+
+    /**
+     * Returns the index of every type, the particles have unique types
+     */
+    static std::vector<std::size_t> indexOfType(ParticleContainer& pc) {
+        std::vector<std::size_t> index(pc.size());
+        for (std::size_t i = 0; i < pc.size(); i++) {
+            index[pc.type()[i]] = i;
+        }
+        return index;
+    }
+
+    std::list<Particle> init;
+    Domain domain;
+    LennardJonesMolecule lj{5, 1};
+};
+
+TEST_F(ReorderTest, keepsTheParticles) {
+    ParticleContainer pc(init.size(), init, 2.5, 0.3);
+    calculateF(pc, lj);
+    pc.nextIteration();
+    calculateF(pc, lj);
+
+    ParticleContainer reordered(init.size(), init, 2.5, 0.3);
+    calculateF(reordered, lj);
+    reordered.nextIteration();
+    calculateF(reordered, lj);
+    reordered.reorder();
+
+    ASSERT_EQ(pc.size(), reordered.size());
+    // the order changed
+    bool moved = false;
+    for (std::size_t i = 0; i < pc.size(); i++) {
+        moved |= pc.type()[i] != reordered.type()[i];
+    }
+    ASSERT_TRUE(moved);
+
+    auto index = indexOfType(reordered);
+    for (std::size_t i = 0; i < pc.size(); i++) {
+        const std::size_t j = index[pc.type()[i]];
+        for (int d = 0; d < 3; d++) {
+            ASSERT_EQ(pc.position(d)[i], reordered.position(d)[j]);
+            ASSERT_EQ(pc.velocity(d)[i], reordered.velocity(d)[j]);
+            ASSERT_EQ(pc.force(d)[i], reordered.force(d)[j]);
+            ASSERT_EQ(pc.oldForce(d)[i], reordered.oldForce(d)[j]);
+        }
+        ASSERT_EQ(pc.mass()[i], reordered.mass()[j]);
+    }
+}
+
+TEST_F(ReorderTest, neighboursAreCloseInMemory) {
+    ParticleContainer pc(init.size(), init, 1.2, 0);
+    pc.reorder();
+
+    // the mean index distance of the particles in neighbouring lattice points
+    auto meanDistance = [&](ParticleContainer& c) {
+        auto index = indexOfType(c);
+        double sum = 0;
+        int pairs = 0;
+        for (int t = 0; t + 1 < (int)c.size(); t++) {
+            // the next lattice point in x
+            if (t % 7 == 6) {
+                continue;
+            }
+            sum += std::abs((double)index[t] - (double)index[t + 1]);
+            pairs++;
+        }
+        return sum / pairs;
+    };
+
+    ParticleContainer scrambled(init.size(), init, 1.2, 0);
+    ASSERT_LT(meanDistance(pc), meanDistance(scrambled) / 4);
+}
+
+TEST_F(ReorderTest, forcesAreUnchanged) {
+    Domain periodic = domain;
+    periodic.boundaries.fill(Boundary::periodic);
+
+    for (const Domain& d : {Domain{}, periodic}) {
+        for (double skin : {0., 0.3}) {
+            ParticleContainer pc(init.size(), init, 2, skin, d);
+            ParticleContainer reordered(init.size(), init, 2, skin, d);
+
+            for (int step = 0; step < 20; step++) {
+                for (ParticleContainer* c : {&pc, &reordered}) {
+                    calculateX(*c, 0.002, 0.000004);
+                    calculateF(*c, lj);
+                    calculateV(*c, 0.002);
+                }
+                if (step % 5 == 2) {
+                    reordered.reorder();
+                }
+            }
+            // the Verlet lists were renumbered instead of rebuilt
+            ASSERT_EQ(pc.getRebuildCount(), reordered.getRebuildCount());
+
+            auto index = indexOfType(reordered);
+            for (std::size_t i = 0; i < pc.size(); i++) {
+                const std::size_t j = index[pc.type()[i]];
+                for (int k = 0; k < 3; k++) {
+                    ASSERT_NEAR(pc.position(k)[i], reordered.position(k)[j],
+                                1e-9 * (1 + std::abs(pc.position(k)[i])));
+                    ASSERT_NEAR(pc.force(k)[i], reordered.force(k)[j],
+                                1e-9 * (1 + std::abs(pc.force(k)[i])))
+                        << "skin " << skin;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <list>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "simulation/StoermerVerlet.h"
+#include "utils/ArrayUtils.h"
+
+class VerletListTest : public testing::Test {
+   protected:
+    VerletListTest() {
+        for (int x = 0; x < 5; x++) {
+            for (int y = 0; y < 5; y++) {
+                for (int z = 0; z < 5; z++) {
+                    std::array<double, 3> pos = {x * 1.2, y * 1.2, z * 1.2};
+                    // every particle moves in another direction
+                    std::array<double, 3> v = {0.1 * (x - 2), 0.1 * (y - 2),
+                                               0.1 * (z - 2)};
+                    init.emplace_back(pos, v, 1, 0);
+                }
+            }
+        }
+    }
+
+    /**
+     * Counts all pairs closer than the cutoff by brute force
+     */
+    static std::size_t countPairs(ParticleContainer& pc, double cutoff) {
+        std::size_t count = 0;
+        for (auto p1 = pc.begin(); p1 != pc.end(); p1++) {
+            for (auto p2 = p1 + 1; p2 != pc.end(); p2++) {
+                if (ArrayUtils::L2Norm(p1->getX() - p2->getX()) <= cutoff) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    std::list<Particle> init;
+    double cutoff = 2.5;
+};
+
+TEST_F(VerletListTest, findsAllPairsWhileMoving) {
+    ParticleContainer pc(init.size(), init, cutoff, 0.4);
+
+    for (int i = 0; i < 40; i++) {
+        std::size_t count = 0;
+        pc.forEachPair([&count](std::size_t, std::size_t) { count++; });
+        ASSERT_EQ(countPairs(pc, cutoff), count) << "iteration: " << i;
+
+        // moves every particle by at most 0.035 per iteration
+        calculateX(pc, 0.1, 0.01);
+    }
+}
+
+TEST_F(VerletListTest, rebuildsOnlyAfterHalfSkin) {
+    ParticleContainer pc(init.size(), init, cutoff, 0.4);
+
+    pc.forEachPair([](std::size_t, std::size_t) {});
+    ASSERT_EQ(1, pc.getRebuildCount());
+
+    // the fastest particle moves sqrt(3) * 0.02 per iteration, so half of the
+    // skin is reached in the 6th iteration
+    for (int i = 0; i < 5; i++) {
+        calculateX(pc, 0.1, 0.01);
+        pc.forEachPair([](std::size_t, std::size_t) {});
+    }
+    ASSERT_EQ(1, pc.getRebuildCount());
+
+    calculateX(pc, 0.1, 0.01);
+    pc.forEachPair([](std::size_t, std::size_t) {});
+    ASSERT_EQ(2, pc.getRebuildCount());
+}
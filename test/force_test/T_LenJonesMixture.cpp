@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <list>
+#include <vector>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/LennardJonesMixture.h"
+#include "force/LennardJonesMolecule.h"
+#include "simulation/StoermerVerlet.h"
+#include "utils/ArrayUtils.h"
+#include "utils/Simd.h"
+
+TEST(LJMixture_test, mixingRules) {
+    LennardJonesMixture mixture({1, 4, 0.5}, {1, 1.2, 0.8});
+    ASSERT_EQ(3, mixture.getTypes());
+
+    const std::vector<double> epsilons = {1, 4, 0.5};
+    const std::vector<double> sigmas = {1, 1.2, 0.8};
+    for (int a = 0; a < 3; a++) {
+        for (int b = 0; b < 3; b++) {
+            LennardJonesMolecule pair(std::sqrt(epsilons[a] * epsilons[b]),
+                                      (sigmas[a] + sigmas[b]) / 2);
+            for (double distanceSq : {0.8, 1.3, 4.}) {
+                ASSERT_DOUBLE_EQ(pair.calculateScalar(distanceSq, 1, 1),
+                                 mixture.calculatePairScalar(distanceSq, a, b));
+            }
+        }
+    }
+
+    // calculateForce uses the types of the particles
+    Particle p1({1.1, 0, 0}, {0, 0, 0}, 1, 1);
+    Particle p2({0, 0.2, 0}, {0, 0, 0}, 1, 2);
+    LennardJonesMolecule pair(std::sqrt(4 * 0.5), 1);
+    std::array<double, 3> expected = pair.calculateForce(p1, p2);
+    std::array<double, 3> force = mixture.calculateForce(p1, p2);
+    for (int d = 0; d < 3; d++) {
+        // LennardJonesMolecule::calculateForce uses std::pow
+        ASSERT_NEAR(expected[d], force[d],
+                    1e-12 * (1 + std::abs(expected[d])));
+    }
+}
+
+class LJMixtureForces_test : public testing::Test {
+   protected:
+    LJMixtureForces_test() {
+        // a jittered lattice of three types, so the kernels see every pair
+        // of types in every lane
+        for (int x = 0; x < 5; x++) {
+            for (int y = 0; y < 6; y++) {
+                for (int z = 0; z < 7; z++) {
+                    std::array<double, 3> pos = {
+                        x * 1.1 + 0.03 * ((y + z) % 4),
+                        y * 1.1 + 0.02 * ((x + 2 * z) % 5),
+                        z * 1.1 + 0.05 * ((x * y) % 3)};
+                    init.emplace_back(pos, std::array<double, 3>{0, 0, 0}, 1,
+                                      (x + 2 * y + z) % 3);
+                }
+            }
+        }
+    }
+
+    /**
+     * Calculates the forces of all pairs within the cutoff with
+     * calculateForce
+     */
+    std::vector<std::array<double, 3>> expectedForces() {
+        std::vector<Particle> particles(init.begin(), init.end());
+        std::vector<std::array<double, 3>> f(particles.size(), {0, 0, 0});
+        for (std::size_t i = 0; i < particles.size(); i++) {
+            for (std::size_t j = i + 1; j < particles.size(); j++) {
+                if (ArrayUtils::L2Norm(particles[i].getX() -
+                                       particles[j].getX()) > cutoff) {
+                    continue;
+                }
+                std::array<double, 3> force =
+                    mixture.calculateForce(particles[i], particles[j]);
+                f[i] = f[i] + force;
+                f[j] = f[j] - force;
+            }
+        }
+        return f;
+    }
+
+    std::list<Particle> init;
+    LennardJonesMixture mixture{{1, 2, 0.5}, {1, 1.1, 0.9}};
+    double cutoff = 2.5;
+};
+
+TEST_F(LJMixtureForces_test, kernelsMatchCalculateForce) {
+    auto expected = expectedForces();
+
+    for (SimdLevel level :
+         {SimdLevel::scalar, SimdLevel::avx2, SimdLevel::avx512}) {
+        if (!simd::isSupported(level)) {
+            continue;
+        }
+        for (double skin : {0., 0.3}) {
+            ParticleContainer pc(init.size(), init, cutoff, skin);
+            selectForceFunction(mixture, level)(pc, mixture);
+
+            for (std::size_t i = 0; i < pc.size(); i++) {
+                for (int d = 0; d < 3; d++) {
+                    ASSERT_NEAR(expected[i][d], pc.force(d)[i],
+                                1e-9 * (1 + std::abs(expected[i][d])))
+                        << simd::toString(level) << ", particle " << i
+                        << ", skin " << skin;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(LJMixtureForces_test, singleTypeMatchesMolecule) {
+    for (Particle& p : init) {
+        p = Particle(p.getX(), p.getV(), p.getM(), 0);
+    }
+    LennardJonesMixture single({2, 1.1}, {1.1, 0.9});
+    LennardJonesMolecule molecule(2, 1.1);
+
+    for (SimdLevel level : {SimdLevel::scalar, simd::detect()}) {
+        ParticleContainer a(init.size(), init, cutoff);
+        ParticleContainer b(init.size(), init, cutoff);
+        selectForceFunction(single, level)(a, single);
+        selectForceFunction(molecule, level)(b, molecule);
+
+        for (std::size_t i = 0; i < a.size(); i++) {
+            for (int d = 0; d < 3; d++) {
+                ASSERT_NEAR(b.force(d)[i], a.force(d)[i],
+                            1e-12 * (1 + std::abs(b.force(d)[i])));
+            }
+        }
+    }
+}
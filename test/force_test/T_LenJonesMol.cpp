@@ -1,10 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <list>
+#include <vector>
+
 #include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/LennardJonesKernel.h"
 #include "force/LennardJonesMolecule.h"
+#include "simulation/StoermerVerlet.h"
+#include "utils/ArrayUtils.h"
+#include "utils/Simd.h"
 
 #ifndef TOLERANCE
-#define TOLERANCE 1e-7;
+#define TOLERANCE 1e-7
 #endif
 
 class LJM_test : public testing::Test {
@@ -75,4 +83,116 @@ TEST_F(LJM_test, all) {
     ASSERT_NEAR(-1.91698E-08, res[0], tolerance);
     ASSERT_NEAR(4.67254E-07, res[1], tolerance);
     ASSERT_NEAR(1.05648E-07, res[2], tolerance);
-}
\ No newline at end of file
+}
+/**
+ * Compares the block kernels and the force calculation without SIMD with
+ * calculateForce on a small particle cloud
+ */
+class LJKernel_test : public testing::Test {
+   protected:
+    LJKernel_test() {
+        // irregular positions, so the distances are all different
+        for (int k = 0; k < n; k++) {
+            std::array<double, 3> pos = {0.9 * (k % 4) + 0.013 * k,
+                                         1.1 * ((k / 4) % 3) + 0.021 * k,
+                                         1.05 * (k / 12) - 0.017 * k};
+            particles.emplace_back(pos, v, 1, 0);
+            x.push_back(pos[0]);
+            y.push_back(pos[1]);
+            z.push_back(pos[2]);
+        }
+        for (std::size_t k = 1; k < n; k++) {
+            neighbours.push_back(k);
+        }
+    }
+
+    /**
+     * Calculates the forces between all particles with the function
+     * selectForceFunction picks for the level and checks them against the
+     * sums of calculateForce
+     */
+    void expectSelectedMatchesScalar(SimdLevel level, double cutoff) {
+        std::list<Particle> init(particles.begin(), particles.end());
+        ParticleContainer pc(init.size(), init, cutoff);
+        selectForceFunction(ljm, level)(pc, ljm);
+
+        for (int i = 0; i < n; i++) {
+            std::array<double, 3> expected = {0, 0, 0};
+            for (int k = 0; k < n; k++) {
+                if (k != i && ArrayUtils::L2Norm(particles[i].getX() -
+                                                 particles[k].getX()) <=
+                                  cutoff) {
+                    expected = expected +
+                               ljm.calculateForce(particles[i], particles[k]);
+                }
+            }
+            for (int d = 0; d < 3; d++) {
+                ASSERT_NEAR(expected[d], pc.force(d)[i], tolerance);
+            }
+        }
+    }
+
+    /**
+     * Applies the SIMD kernel of the given level to particle 0 and all others
+     * and checks the forces against calculateForce
+     */
+    void expectMatchesScalar(SimdLevel level, double cutoff) {
+        if (!simd::isSupported(level)) {
+            GTEST_SKIP() << simd::toString(level) << " is not supported";
+        }
+
+        std::vector<double> fx(n, 0), fy(n, 0), fz(n, 0);
+        LJKernelData data = {x.data(),        y.data(),
+                             z.data(),        fx.data(),
+                             fy.data(),       fz.data(),
+                             ljm.getEpsilon24(), ljm.getSigmaSq(),
+                             cutoff * cutoff};
+
+        LJBlockKernel kernel = level == SimdLevel::avx512
+                                   ? ljkernel::blockAVX512
+                                   : ljkernel::blockAVX2;
+        kernel(data, 0, neighbours.data(), neighbours.size());
+
+        std::array<double, 3> expected0 = {0, 0, 0};
+        for (int k = 1; k < n; k++) {
+            std::array<double, 3> expected = {0, 0, 0};
+            if (ArrayUtils::L2Norm(particles[0].getX() -
+                                   particles[k].getX()) <= cutoff) {
+                expected = ljm.calculateForce(particles[0], particles[k]);
+            }
+            expected0 = expected0 + expected;
+
+            ASSERT_NEAR(-expected[0], fx[k], tolerance);
+            ASSERT_NEAR(-expected[1], fy[k], tolerance);
+            ASSERT_NEAR(-expected[2], fz[k], tolerance);
+        }
+        ASSERT_NEAR(expected0[0], fx[0], tolerance);
+        ASSERT_NEAR(expected0[1], fy[0], tolerance);
+        ASSERT_NEAR(expected0[2], fz[0], tolerance);
+    }
+
+    // not a multiple of 4 or 8, so the remainder is tested as well
+    static constexpr int n = 23;
+
+    std::array<double, 3> v = {0, 0, 0};
+    std::vector<Particle> particles;
+    std::vector<double> x, y, z;
+    std::vector<std::size_t> neighbours;
+    LennardJonesMolecule ljm = LennardJonesMolecule(1.5, 0.9);
+
+    double tolerance = TOLERANCE;
+};
+
+TEST_F(LJKernel_test, scalar) {
+    expectSelectedMatchesScalar(SimdLevel::scalar, 100);
+}
+
+TEST_F(LJKernel_test, avx2) { expectMatchesScalar(SimdLevel::avx2, 100); }
+
+TEST_F(LJKernel_test, avx512) { expectMatchesScalar(SimdLevel::avx512, 100); }
+
+TEST_F(LJKernel_test, cutoff) {
+    expectSelectedMatchesScalar(SimdLevel::scalar, 2.);
+    expectMatchesScalar(SimdLevel::avx2, 2.);
+    expectMatchesScalar(SimdLevel::avx512, 2.);
+}
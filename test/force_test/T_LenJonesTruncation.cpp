@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <list>
+#include <vector>
+
+#include "container/Domain.h"
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/LennardJonesMolecule.h"
+#include "force/LennardJonesShifted.h"
+#include "force/LennardJonesSmooth.h"
+#include "simulation/StoermerVerlet.h"
+
+namespace {
+/**
+ * The plain Lennard-Jones potential
+ */
+double plainPotential(double epsilon, double sigma, double distanceSq) {
+    const double s6 = std::pow(sigma * sigma / distanceSq, 3);
+    return 4 * epsilon * (s6 * s6 - s6);
+}
+
+/**
+ * Checks that the scalar of the force is -dU/dr / r for the potential U
+ */
+template <typename ForceT>
+void expectForceIsDerivative(const ForceT& force, double from, double to) {
+    const double h = 1e-6;
+    for (double r = from; r < to; r += 0.0371) {
+        const double derivative =
+            (force.calculatePotential((r + h) * (r + h)) -
+             force.calculatePotential((r - h) * (r - h))) /
+            (2 * h);
+        const double s = force.calculateScalar(r * r, 1, 1);
+        ASSERT_NEAR(-derivative / r, s, 1e-6 * (1 + std::abs(s)))
+            << "r " << r;
+    }
+}
+}  // namespace
+
+TEST(LJTruncation_test, shiftedVanishesAtCutoff) {
+    LennardJonesShifted shifted(2, 1.1, 2.5);
+    LennardJonesMolecule plain(2, 1.1);
+
+    const double below = 2.5 * 2.5 * (1 - 1e-12);
+    ASSERT_NEAR(0, shifted.calculateScalar(below, 1, 1), 1e-10);
+    ASSERT_NEAR(0, shifted.calculatePotential(below), 1e-10);
+    ASSERT_EQ(0, shifted.calculateScalar(2.6 * 2.6, 1, 1));
+    ASSERT_EQ(0, shifted.calculatePotential(2.6 * 2.6));
+
+    // the force differs from the plain one by a constant scalar
+    const double shift = plain.calculateScalar(2.5 * 2.5, 1, 1);
+    for (double distanceSq : {0.9, 1.4, 3.}) {
+        ASSERT_NEAR(plain.calculateScalar(distanceSq, 1, 1) - shift,
+                    shifted.calculateScalar(distanceSq, 1, 1), 1e-12);
+    }
+
+    expectForceIsDerivative(shifted, 0.95, 2.5);
+}
+
+TEST(LJTruncation_test, smoothSwitchesBetweenRadii) {
+    LennardJonesSmooth smooth(2, 1.1, 1.9, 2.5);
+    LennardJonesMolecule plain(2, 1.1);
+
+    // the plain potential below r_l
+    for (double r : {0.95, 1.2, 1.85}) {
+        ASSERT_DOUBLE_EQ(plain.calculateScalar(r * r, 1, 1),
+                         smooth.calculateScalar(r * r, 1, 1));
+        ASSERT_NEAR(plainPotential(2, 1.1, r * r),
+                    smooth.calculatePotential(r * r), 1e-12);
+    }
+
+    // continuous at both radii and 0 beyond the cutoff
+    for (double r : {1.9, 2.5}) {
+        const double inside = r * r * (1 - 1e-9);
+        const double outside = r * r * (1 + 1e-9);
+        ASSERT_NEAR(smooth.calculateScalar(inside, 1, 1),
+                    smooth.calculateScalar(outside, 1, 1), 1e-8);
+        ASSERT_NEAR(smooth.calculatePotential(inside),
+                    smooth.calculatePotential(outside), 1e-8);
+    }
+    ASSERT_EQ(0, smooth.calculateScalar(2.6 * 2.6, 1, 1));
+    ASSERT_EQ(0, smooth.calculatePotential(2.6 * 2.6));
+
+    expectForceIsDerivative(smooth, 0.95, 2.5);
+}
+
+class LJEnergy_test : public testing::Test {
+   protected:
+    LJEnergy_test() {
+        // a warm gas in a periodic box
+        for (int x = 0; x < 5; x++) {
+            for (int y = 0; y < 5; y++) {
+                for (int z = 0; z < 5; z++) {
+                    std::array<double, 3> pos = {x * 1.5 + 0.1 * (y % 3),
+                                                 y * 1.5 + 0.1 * (z % 2),
+                                                 z * 1.5 + 0.1 * (x % 4)};
+                    std::array<double, 3> v = {std::sin(x + 2. * y + 3 * z),
+                                               std::cos(3. * x + y + 2 * z),
+                                               std::sin(2. * x + 3 * y + z)};
+                    init.emplace_back(pos, v, 1, 0);
+                }
+            }
+        }
+        domain.size = {7.5, 7.5, 7.5};
+        domain.boundaries.fill(Boundary::periodic);
+    }
+
+    /**
+     * Runs the simulation and returns the largest deviation of the total
+     * energy from its start, relative to the kinetic energy at the start
+     */
+    template <typename ForceT, typename PotentialT>
+    double energyDrift(const ForceT& force, PotentialT potential) {
+        ParticleContainer pc(init.size(), init, cutoff, 0.3, domain);
+        calculateF(pc, force);
+
+        auto energy = [&]() {
+            double kinetic = 0;
+            double pot = 0;
+            for (std::size_t i = 0; i < pc.size(); i++) {
+                for (int d = 0; d < 3; d++) {
+                    kinetic += 0.5 * pc.velocity(d)[i] * pc.velocity(d)[i];
+                }
+                for (std::size_t j = i + 1; j < pc.size(); j++) {
+                    double distanceSq = 0;
+                    for (int d = 0; d < 3; d++) {
+                        double dx = pc.position(d)[i] - pc.position(d)[j];
+                        dx -= domain.size[d] * std::round(dx / domain.size[d]);
+                        distanceSq += dx * dx;
+                    }
+                    pot += potential(distanceSq);
+                }
+            }
+            return std::array<double, 2>{kinetic, kinetic + pot};
+        };
+
+        const auto start = energy();
+        double drift = 0;
+        for (int step = 0; step < 2000; step++) {
+            calculateX(pc, dt, dt * dt);
+            calculateF(pc, force);
+            calculateV(pc, dt);
+            if (step % 100 == 99) {
+                drift = std::max(drift, std::abs(energy()[1] - start[1]));
+            }
+        }
+        return drift / start[0];
+    }
+
+    std::list<Particle> init;
+    Domain domain;
+    double cutoff = 2.;
+    double dt = 0.002;
+};
+
+TEST_F(LJEnergy_test, truncationConservesEnergy) {
+    LennardJonesMolecule plain(1, 1);
+    LennardJonesShifted shifted(1, 1, cutoff);
+    LennardJonesSmooth smooth(1, 1, 1.6, cutoff);
+
+    const double plainDrift = energyDrift(plain, [&](double distanceSq) {
+        return distanceSq <= cutoff * cutoff
+                   ? plainPotential(1, 1, distanceSq)
+                   : 0.;
+    });
+    const double shiftedDrift = energyDrift(shifted, [&](double distanceSq) {
+        return shifted.calculatePotential(distanceSq);
+    });
+    const double smoothDrift = energyDrift(smooth, [&](double distanceSq) {
+        return smooth.calculatePotential(distanceSq);
+    });
+
+    // the plain potential loses energy whenever a pair crosses the cutoff
+    ASSERT_LT(shiftedDrift, plainDrift / 100);
+    ASSERT_LT(smoothDrift, plainDrift / 100);
+}
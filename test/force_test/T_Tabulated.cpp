@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <list>
+#include <stdexcept>
+#include <string>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/CentralForce.h"
+#include "force/LennardJonesMolecule.h"
+#include "force/LennardJonesShifted.h"
+#include "force/Planet.h"
+#include "force/TabulatedForce.h"
+#include "simulation/StoermerVerlet.h"
+
+namespace {
+/**
+ * Returns the largest error of the table relative to the largest magnitude of
+ * the force between the radii
+ */
+double relativeError(const CentralForce& exact, const TabulatedForce& table,
+                     double from, double to) {
+    double error = 0;
+    double magnitude = 0;
+    for (double r = from; r < to; r += 0.000731) {
+        const double expected = exact.calculateScalar(r * r, 1, 1);
+        error = std::max(error,
+                         std::abs(table.calculateScalar(r * r, 1, 1) -
+                                  expected));
+        magnitude = std::max(magnitude, std::abs(expected));
+    }
+    return error / magnitude;
+}
+}  // namespace
+
+TEST(Tabulated_test, interpolatesLennardJones) {
+    LennardJonesMolecule lj(5, 1);
+    TabulatedForce linear(lj, 0.8, 2.5, 4096, Interpolation::linear);
+    TabulatedForce cubic(lj, 0.8, 2.5, 4096, Interpolation::cubic);
+
+    // both are exact on the grid points
+    for (int k : {0, 17, 4096}) {
+        const double distanceSq = 0.64 + k * (6.25 - 0.64) / 4096;
+        const double expected = lj.calculateScalar(distanceSq, 1, 1);
+        ASSERT_NEAR(expected, linear.calculateScalar(distanceSq, 1, 1),
+                    1e-12 * std::abs(expected));
+        ASSERT_NEAR(expected, cubic.calculateScalar(distanceSq, 1, 1),
+                    1e-12 * std::abs(expected));
+    }
+
+    const double linearError = relativeError(lj, linear, 0.8, 2.5);
+    const double cubicError = relativeError(lj, cubic, 0.8, 2.5);
+    ASSERT_LT(linearError, 1e-4);
+    ASSERT_LT(cubicError, 1e-8);
+
+    // clamped below the inner radius and 0 beyond the cutoff
+    ASSERT_DOUBLE_EQ(cubic.calculateScalar(0.64, 1, 1),
+                     cubic.calculateScalar(0.5, 1, 1));
+    ASSERT_EQ(0, cubic.calculateScalar(2.51 * 2.51, 1, 1));
+
+    ASSERT_THROW(TabulatedForce(lj, 0, 2.5, 10), std::invalid_argument);
+    ASSERT_THROW(TabulatedForce(lj, 1, 1, 10), std::invalid_argument);
+    ASSERT_THROW(TabulatedForce(lj, 1, 2, 0), std::invalid_argument);
+}
+
+TEST(Tabulated_test, scalesPlanetsByMasses) {
+    Planet planet;
+    TabulatedForce table(planet, 1, 10, 8192, Interpolation::cubic, true);
+
+    for (double r : {1.3, 4.2, 9.9}) {
+        const double expected = planet.calculateScalar(r * r, 2, 0.5);
+        ASSERT_NEAR(expected, table.calculateScalar(r * r, 2, 0.5),
+                    1e-6 * std::abs(expected));
+    }
+}
+
+TEST(Tabulated_test, readsFile) {
+    LennardJonesMolecule lj(1, 1);
+    const std::string filename = testing::TempDir() + "tabulated_test.txt";
+    {
+        std::ofstream file(filename);
+        file.precision(17);
+        file << "# r F\n\n";
+        // fine enough that the linear interpolation of the file is accurate
+        for (int k = 0; k <= 16000; k++) {
+            const double r = 0.9 + k * 0.0001;
+            // the magnitude of the force is s * r, positive if repulsive
+            file << r << " " << lj.calculateScalar(r * r, 1, 1) * r << "\n";
+        }
+    }
+
+    TabulatedForce table =
+        TabulatedForce::fromFile(filename, 2048, Interpolation::cubic);
+    ASSERT_DOUBLE_EQ(2.5, table.getCutoff());
+    ASSERT_LT(relativeError(lj, table, 0.9, 2.5), 1e-4);
+
+    {
+        std::ofstream file(filename);
+        file << "1 2\n0.5 1\n";
+    }
+    ASSERT_THROW(TabulatedForce::fromFile(filename, 10, Interpolation::linear),
+                 std::runtime_error);
+    {
+        std::ofstream file(filename);
+        file << "1 2 3\n";
+    }
+    ASSERT_THROW(TabulatedForce::fromFile(filename, 10, Interpolation::linear),
+                 std::runtime_error);
+}
+
+TEST(Tabulated_test, samplesOnlyInsideCoarseTables) {
+    const std::string filename = testing::TempDir() + "coarse_test.txt";
+    {
+        std::ofstream file(filename);
+        file << "0.1 100\n1 1\n3 0\n";
+    }
+    TabulatedForce table =
+        TabulatedForce::fromFile(filename, 10, Interpolation::cubic);
+    for (double r : {0.1, 0.2, 0.5, 2.9, 3.}) {
+        ASSERT_TRUE(std::isfinite(table.calculateScalar(r * r, 1, 1)))
+            << "r " << r;
+    }
+    // exact on the grid points, also at both ends
+    ASSERT_NEAR(1000, table.calculateScalar(0.01, 1, 1), 1e-9);
+    ASSERT_NEAR(0, table.calculateScalar(9, 1, 1), 1e-12);
+
+    Planet planet;
+    TabulatedForce gravity(planet, 0.1, 3, 10, Interpolation::cubic, true);
+    ASSERT_TRUE(std::isfinite(gravity.calculateScalar(0.01, 1, 1)));
+
+    // the force truncated at the cutoff keeps its slope at the last point
+    LennardJonesShifted shifted(1, 1, 2.5);
+    TabulatedForce truncated(shifted, 0.9, 2.5, 64, Interpolation::cubic);
+    ASSERT_LT(relativeError(shifted, truncated, 2.3, 2.5), 1e-4);
+}
+
+TEST(Tabulated_test, forcesMatchLennardJones) {
+    std::list<Particle> init;
+    for (int x = 0; x < 6; x++) {
+        for (int y = 0; y < 6; y++) {
+            for (int z = 0; z < 6; z++) {
+                std::array<double, 3> pos = {x * 1.1 + 0.04 * ((y + z) % 3),
+                                             y * 1.1 + 0.03 * ((x * z) % 4),
+                                             z * 1.1 + 0.02 * ((x + y) % 5)};
+                init.emplace_back(pos, std::array<double, 3>{0, 0, 0}, 1);
+            }
+        }
+    }
+    LennardJonesMolecule lj(5, 1);
+    TabulatedForce table(lj, 0.8, 2.5, 4096);
+
+    ParticleContainer expected(init.size(), init, 2.5, 0);
+    ParticleContainer tabulated(init.size(), init, 2.5, 0);
+    calculateF(expected, lj);
+    selectForceFunction(table)(tabulated, table);
+
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        for (int d = 0; d < 3; d++) {
+            ASSERT_NEAR(expected.force(d)[i], tabulated.force(d)[i],
+                        1e-7 * (1 + std::abs(expected.force(d)[i])));
+        }
+    }
+}
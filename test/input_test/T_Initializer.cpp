@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <stdexcept>
+#include <string>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "input/CuboidGenerator.h"
+#include "input/FileReader.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * Checks that the particles in the container at offset equal the list
+ */
+void expectSameParticles(ParticleContainer& container, std::size_t offset,
+                         const std::list<Particle>& expected) {
+    std::size_t i = offset;
+    for (const Particle& p : expected) {
+        for (int d = 0; d < 3; d++) {
+            ASSERT_EQ(p.getX()[d], container.position(d)[i]);
+            ASSERT_EQ(p.getV()[d], container.velocity(d)[i]);
+        }
+        ASSERT_EQ(p.getM(), container.mass()[i]);
+        ASSERT_EQ(p.getType(), container.type()[i]);
+        i++;
+    }
+}
+
+TEST(InitializerTest, cuboidReadIntoMatchesReadData) {
+    // the random velocities only depend on the id and the index
+    CuboidGenerator cuboid(3, 4, 5, 1.5, 2, 0.5, {1, -2, 0.5}, {0.1, 0, -1}, 3);
+    ASSERT_EQ(60, cuboid.count());
+
+    std::list<Particle> expected;
+    cuboid.readData(expected);
+
+    ParticleContainer container(70);
+    cuboid.readInto(container, 7);
+    expectSameParticles(container, 7, expected);
+
+    // the particles around the cuboid are untouched
+    ASSERT_EQ(0, container.mass()[6]);
+    ASSERT_EQ(0, container.mass()[67]);
+}
+
+TEST(InitializerTest, cuboidIndependentOfThreads) {
+    CuboidGenerator cuboid(20, 30, 40, 1.1225, 1, 0.1, {0, 0, 0}, {0, 0, 0});
+    ParticleContainer serial(cuboid.count());
+    ParticleContainer parallel(cuboid.count());
+
+#ifdef _OPENMP
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    cuboid.readInto(serial, 0);
+    omp_set_num_threads(4);
+    cuboid.readInto(parallel, 0);
+    omp_set_num_threads(threads);
+#else
+    cuboid.readInto(serial, 0);
+    cuboid.readInto(parallel, 0);
+#endif
+
+    for (std::size_t i = 0; i < cuboid.count(); i++) {
+        for (int d = 0; d < 3; d++) {
+            ASSERT_EQ(serial.velocity(d)[i], parallel.velocity(d)[i]);
+        }
+    }
+}
+
+TEST(InitializerTest, cuboidsWithDifferentIds) {
+    CuboidGenerator first(2, 2, 2, 1, 1, 0.1, {0, 0, 0}, {0, 0, 0}, 0);
+    CuboidGenerator second(2, 2, 2, 1, 1, 0.1, {0, 0, 0}, {0, 0, 0}, 1);
+    ParticleContainer container(16);
+    first.readInto(container, 0);
+    second.readInto(container, 8);
+
+    for (std::size_t i = 0; i < 8; i++) {
+        ASSERT_NE(container.velocity(0)[i], container.velocity(0)[8 + i]);
+    }
+}
+
+TEST(InitializerTest, emptyCuboid) {
+    CuboidGenerator cuboid(0, 4, 5, 1.5, 2, 0, {0, 0, 0}, {0, 0, 0});
+    ASSERT_EQ(0, cuboid.count());
+}
+
+/**
+ * Writes the content to a temporary file and returns its name
+ */
+std::string writeFile(const std::string& content) {
+    std::string filename = testing::TempDir() + "initializer_test.txt";
+    std::ofstream file(filename, std::ios::binary);
+    file << content;
+    return filename;
+}
+
+/**
+ * Returns the message of the error reading the content
+ */
+std::string readError(const std::string& content) {
+    std::string filename = writeFile(content);
+    FileReader reader(filename.c_str());
+    try {
+        ParticleContainer container(reader.count());
+        reader.readInto(container, 0);
+    } catch (const std::runtime_error& e) {
+        std::remove(filename.c_str());
+        return e.what();
+    }
+    std::remove(filename.c_str());
+    return "";
+}
+
+TEST(InitializerTest, fileFormatVariants) {
+    // windows line endings, tabs, a leading plus and no final newline
+    std::string filename =
+        writeFile("#comment\r\n\r\n2\r\n1\t2 3 +4 5 6 7\r\n-1e3 0 0 0 0 0 .5");
+    FileReader reader(filename.c_str());
+    ASSERT_EQ(2, reader.count());
+
+    ParticleContainer container(2);
+    reader.readInto(container, 0);
+    ASSERT_EQ(1, container.position(0)[0]);
+    ASSERT_EQ(4, container.velocity(0)[0]);
+    ASSERT_EQ(7, container.mass()[0]);
+    ASSERT_EQ(-1000, container.position(0)[1]);
+    ASSERT_EQ(0.5, container.mass()[1]);
+
+    std::remove(filename.c_str());
+}
+
+TEST(InitializerTest, fileErrorsContainLine) {
+    const std::string name = "initializer_test.txt:";
+    ASSERT_NE(
+        std::string::npos,
+        readError("# a\n2\n0 0 0 0 0 0 1\n0 0 0 0 1\n").find(name + "4:"));
+    ASSERT_NE(std::string::npos,
+              readError("2\n0 0 0 0 0 0 1\n0 0 0 0 x 0 1\n").find(name + "3:"));
+    ASSERT_NE(std::string::npos,
+              readError("3\n0 0 0 0 0 0 1\n").find(name + "3:"));
+    ASSERT_NE(std::string::npos,
+              readError("# only a comment\n").find(name + "1:"));
+    ASSERT_NE(std::string::npos,
+              readError("\n\nmany\n").find(name + "3:"));
+    // the type is the only optional value and has to be a natural number
+    ASSERT_NE(std::string::npos,
+              readError("1\n0 0 0 0 0 0 1 1 1\n").find(name + "2:"));
+    ASSERT_NE(std::string::npos,
+              readError("1\n0 0 0 0 0 0 1 -1\n").find(name + "2:"));
+    ASSERT_NE(std::string::npos,
+              readError("1\n0 0 0 0 0 0 1 1.5\n").find(name + "2:"));
+}
+
+TEST(InitializerTest, types) {
+    std::string filename = writeFile("3\n0 0 0 0 0 0 1 2\n0 0 0 0 0 0 1\n"
+                                     "0 0 0 0 0 0 1 \t1 \r\n");
+    FileReader reader(filename.c_str());
+    CuboidGenerator cuboid(2, 1, 1, 1, 1, 0, {0, 0, 0}, {0, 0, 0}, 0, 3);
+    ParticleContainer container(5);
+    reader.readInto(container, 0);
+    cuboid.readInto(container, 3);
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(2, container.type()[0]);
+    ASSERT_EQ(0, container.type()[1]);
+    ASSERT_EQ(1, container.type()[2]);
+    ASSERT_EQ(3, container.type()[3]);
+    ASSERT_EQ(3, container.type()[4]);
+
+    std::list<Particle> particles;
+    cuboid.readData(particles);
+    ASSERT_EQ(3, particles.front().getType());
+}
+
+TEST(InitializerTest, fileReadIntoMatchesReadData) {
+    std::string filename = testing::TempDir() + "initializer_test.txt";
+    {
+        std::ofstream file(filename);
+        file << "# comment\n3\n"
+             << "0 0 0 0 1 0 2.5\n"
+             << "1.5 -2 3 0.5 0 0 1\n"
+             << "4 5 6 -1 -2 -3 0.25\n";
+    }
+
+    FileReader reader(filename.c_str());
+    ASSERT_EQ(3, reader.count());
+
+    std::list<Particle> expected;
+    reader.readData(expected);
+
+    ParticleContainer container(5);
+    reader.readInto(container, 2);
+    expectSameParticles(container, 2, expected);
+
+    std::remove(filename.c_str());
+}
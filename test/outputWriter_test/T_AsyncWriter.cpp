@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "outputWriter/AsyncWriter.h"
+
+/**
+ * Remembers the x coordinate of the first particle and the iteration of
+ * every output, optionally taking some time like a slow disk
+ */
+class RecordingWriter : public Writer {
+   public:
+    explicit RecordingWriter(int delayMs_ = 0) : delayMs(delayMs_) {}
+
+    void plotParticles(ParticleContainer& container, const std::string&,
+                       int iteration) override {
+        if (iteration < 0) {
+            throw std::runtime_error("negative iteration");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+        std::lock_guard<std::mutex> lock(mutex);
+        iterations.push_back(iteration);
+        xs.push_back(container.position(0)[0]);
+        sizes.push_back(container.size());
+    }
+
+    std::string typeString() override { return "Recording"; }
+
+    int delayMs;
+    std::mutex mutex;
+    std::vector<int> iterations;
+    std::vector<double> xs;
+    std::vector<std::size_t> sizes;
+};
+
+class AsyncWriterTest : public testing::Test {
+   protected:
+    AsyncWriterTest() {
+        std::array<double, 3> v = {0, 0, 0};
+        for (int i = 0; i < 5; i++) {
+            std::array<double, 3> x = {(double)i, 0, 0};
+            init.emplace_back(x, v, 1, 0);
+        }
+    }
+
+    std::list<Particle> init;
+};
+
+TEST_F(AsyncWriterTest, writesSnapshotsInOrder) {
+    auto recorder = std::make_shared<RecordingWriter>(2);
+    ParticleContainer pc(init.size(), init);
+
+    {
+        outputWriter::AsyncWriter writer(recorder, 2);
+        for (int iteration = 0; iteration < 10; iteration++) {
+            pc.position(0)[0] = iteration * 0.5;
+            writer.plotParticles(pc, "unused", iteration);
+            // the snapshot is unaffected by later changes
+            pc.position(0)[0] = -1;
+        }
+        writer.flush();
+
+        ASSERT_EQ(10, recorder->iterations.size());
+    }
+
+    for (int iteration = 0; iteration < 10; iteration++) {
+        ASSERT_EQ(iteration, recorder->iterations[iteration]);
+        ASSERT_EQ(iteration * 0.5, recorder->xs[iteration]);
+        ASSERT_EQ(init.size(), recorder->sizes[iteration]);
+    }
+}
+
+TEST_F(AsyncWriterTest, destructorWritesQueuedOutput) {
+    auto recorder = std::make_shared<RecordingWriter>(5);
+    ParticleContainer pc(init.size(), init);
+
+    {
+        outputWriter::AsyncWriter writer(recorder, 3);
+        for (int iteration = 0; iteration < 4; iteration++) {
+            writer.plotParticles(pc, "unused", iteration);
+        }
+    }
+
+    ASSERT_EQ(4, recorder->iterations.size());
+}
+
+TEST_F(AsyncWriterTest, rethrowsWriterErrors) {
+    auto recorder = std::make_shared<RecordingWriter>();
+    ParticleContainer pc(init.size(), init);
+    outputWriter::AsyncWriter writer(recorder, 1);
+
+    writer.plotParticles(pc, "unused", -1);
+    ASSERT_THROW(writer.flush(), std::runtime_error);
+
+    // the writer keeps working afterwards
+    writer.plotParticles(pc, "unused", 1);
+    writer.flush();
+    ASSERT_EQ(1, recorder->iterations.size());
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/LennardJonesMolecule.h"
+#include "input/CheckpointReader.h"
+#include "input/CuboidGenerator.h"
+#include "outputWriter/CheckpointWriter.h"
+#include "simulation/Simulation.h"
+#include "simulation/StoermerVerlet.h"
+
+/**
+ * Discards all output of the simulation
+ */
+class DiscardingWriter : public Writer {
+   public:
+    void plotParticles(ParticleContainer&, const std::string&, int) override {}
+
+    std::string typeString() override { return "Discarding"; }
+};
+
+/**
+ * Returns the content of the file
+ */
+std::string readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+}
+
+/**
+ * Returns a small cuboid whose particles interact with each other
+ */
+ParticleContainer cuboidContainer(double cutoff) {
+    CuboidGenerator cuboid(4, 3, 2, 1.1225, 1, 0.1, {0, 0, 0}, {0, 0, 0}, 5);
+    ParticleContainer container(cuboid.count(), cutoff);
+    cuboid.readInto(container, 0);
+    return container;
+}
+
+TEST(CheckpointTest, roundtrip) {
+    const std::string prefix = testing::TempDir() + "checkpoint_roundtrip";
+    ParticleContainer written = cuboidContainer(3);
+    for (std::size_t i = 0; i < written.size(); i++) {
+        written.type()[i] = (int)i % 3;
+    }
+    LennardJonesMolecule force(5, 1);
+    calculateF(written, force);
+    written.nextIteration();
+    calculateF(written, force);
+
+    outputWriter::CheckpointWriter writer(0.01);
+    writer.plotParticles(written, prefix, 41);
+
+    CheckpointReader reader(prefix + ".checkpoint");
+    ASSERT_EQ(written.size(), reader.count());
+    ASSERT_EQ(41, reader.getIteration());
+    ASSERT_DOUBLE_EQ(0.42, reader.getTime());
+    ASSERT_EQ(0.01, reader.getDt());
+
+    ParticleContainer read(written.size() + 2, 3);
+    reader.readInto(read, 1);
+    for (std::size_t i = 0; i < written.size(); i++) {
+        for (int d = 0; d < 3; d++) {
+            ASSERT_EQ(written.position(d)[i], read.position(d)[i + 1]);
+            ASSERT_EQ(written.velocity(d)[i], read.velocity(d)[i + 1]);
+            ASSERT_EQ(written.force(d)[i], read.force(d)[i + 1]);
+            ASSERT_EQ(written.oldForce(d)[i], read.oldForce(d)[i + 1]);
+        }
+        ASSERT_EQ(written.mass()[i], read.mass()[i + 1]);
+        ASSERT_EQ(written.type()[i], read.type()[i + 1]);
+    }
+
+    // readData restores the same particles
+    std::list<Particle> particles;
+    reader.readData(particles);
+    ASSERT_EQ(written.size(), particles.size());
+    std::size_t i = 0;
+    for (const Particle& p : particles) {
+        for (int d = 0; d < 3; d++) {
+            ASSERT_EQ(written.position(d)[i], p.getX()[d]);
+            ASSERT_EQ(written.force(d)[i], p.getF()[d]);
+            ASSERT_EQ(written.oldForce(d)[i], p.getOldF()[d]);
+        }
+        ASSERT_EQ(written.type()[i], p.getType());
+        i++;
+    }
+
+    std::remove((prefix + ".checkpoint").c_str());
+}
+
+TEST(CheckpointTest, rejectsInvalidFiles) {
+    const std::string prefix = testing::TempDir() + "checkpoint_invalid";
+    ParticleContainer container = cuboidContainer(0);
+    outputWriter::CheckpointWriter(0.01).plotParticles(container, prefix, 0);
+    const std::string filename = prefix + ".checkpoint";
+
+    const std::string content = readFile(filename);
+    auto writeFile = [&](const std::string& data) {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file << data;
+    };
+
+    // truncated
+    writeFile(content.substr(0, content.size() - 1));
+    ASSERT_THROW(CheckpointReader{filename}, std::runtime_error);
+
+    // shorter than the header
+    writeFile(content.substr(0, 10));
+    ASSERT_THROW(CheckpointReader{filename}, std::runtime_error);
+
+    // not a checkpoint
+    std::string wrongMagic = content;
+    wrongMagic[0] = 'X';
+    writeFile(wrongMagic);
+    ASSERT_THROW(CheckpointReader{filename}, std::runtime_error);
+
+    std::remove(filename.c_str());
+    ASSERT_THROW(CheckpointReader{filename}, std::runtime_error);
+}
+
+TEST(CheckpointTest, rejectsOtherCutoffAndSkin) {
+    const std::string prefix = testing::TempDir() + "checkpoint_parameters";
+    ParticleContainer container = cuboidContainer(2.5);
+    outputWriter::CheckpointWriter(0.01, 2.5, 0.3)
+        .plotParticles(container, prefix, 0);
+    CheckpointReader reader(prefix + ".checkpoint");
+
+    ASSERT_NO_THROW(reader.checkParameters(2.5, 0.3));
+    ASSERT_THROW(reader.checkParameters(3, 0.3), std::runtime_error);
+    ASSERT_THROW(reader.checkParameters(2.5, 0), std::runtime_error);
+    ASSERT_THROW(reader.checkParameters(0, 0), std::runtime_error);
+
+    std::remove((prefix + ".checkpoint").c_str());
+}
+
+TEST(CheckpointTest, restartContinuesTheRun) {
+    const std::string whole = testing::TempDir() + "checkpoint_whole";
+    const std::string split = testing::TempDir() + "checkpoint_split";
+    // a power of two, so the end is an exact multiple of it
+    const double dt = 0x1.0p-11;
+    auto force = std::make_shared<LennardJonesMolecule>(5, 1);
+    auto discard = std::make_shared<DiscardingWriter>();
+    auto checkpoints =
+        std::make_shared<outputWriter::CheckpointWriter>(dt, 3);
+
+    // iterations 0 to 19 at once
+    {
+        Simulation sim(cuboidContainer(3), force, discard, dt, 100, whole);
+        sim.setCheckpoint(checkpoints, 1000);
+        sim.run(0, 19 * dt);
+    }
+
+    // iterations 0 to 9, then 10 to 19 from the checkpoint
+    {
+        Simulation sim(cuboidContainer(3), force, discard, dt, 100, split);
+        sim.setCheckpoint(checkpoints, 1000);
+        sim.run(0, 9 * dt);
+    }
+    {
+        CheckpointReader reader(split + ".checkpoint");
+        ASSERT_EQ(9, reader.getIteration());
+        ParticleContainer restored(reader.count(), 3);
+        reader.readInto(restored, 0);
+
+        Simulation sim(std::move(restored), force, discard, dt, 100, split);
+        sim.setCheckpoint(checkpoints, 1000);
+        sim.run(0, 19 * dt, (int)reader.getIteration() + 1);
+    }
+
+    ASSERT_EQ(19, CheckpointReader(split + ".checkpoint").getIteration());
+    ASSERT_EQ(readFile(whole + ".checkpoint"),
+              readFile(split + ".checkpoint"));
+
+    std::remove((whole + ".checkpoint").c_str());
+    std::remove((split + ".checkpoint").c_str());
+}
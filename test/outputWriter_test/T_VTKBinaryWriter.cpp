@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#ifndef NO_ZLIB
+#include <zlib.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "outputWriter/VTKBinaryWriter.h"
+
+using outputWriter::VTKBinaryWriter;
+
+/**
+ * Writes a few particles and decodes the arrays of the written file again
+ */
+class VTKBinaryWriterTest : public testing::Test {
+   protected:
+    VTKBinaryWriterTest() {
+        for (int i = 0; i < 50; i++) {
+            std::array<double, 3> x = {0.5 * i, -1. * i, 2.25};
+            std::array<double, 3> v = {1, 2, 3. * i};
+            init.emplace_back(x, v, 1. + i, i % 4);
+        }
+    }
+
+    /**
+     * Writes the particles and returns the content of the file
+     */
+    std::string write(VTKBinaryWriter& writer) {
+        ParticleContainer pc(init.size(), init);
+        std::string prefix = testing::TempDir() + "vtkbin_test";
+        writer.plotParticles(pc, prefix, 7);
+
+        std::ifstream file(prefix + "_0007.vtu", std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    static std::vector<unsigned char> decodeBase64(const std::string& text) {
+        std::vector<unsigned char> bytes;
+        std::uint32_t buffer = 0;
+        int bits = 0;
+        for (char c : text) {
+            const char* chars =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+                "+/";
+            const char* pos = std::strchr(chars, c);
+            if (c == '=' || pos == nullptr) {
+                break;
+            }
+            buffer = (buffer << 6) | (std::uint32_t)(pos - chars);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                bytes.push_back((buffer >> bits) & 0xFF);
+            }
+        }
+        return bytes;
+    }
+
+    /**
+     * Returns the decoded bytes of the array with the given name
+     */
+    static std::vector<unsigned char> readArray(const std::string& content,
+                                                const std::string& name,
+                                                bool base64, bool compressed) {
+        std::size_t element = content.find("Name=\"" + name + "\"");
+        std::size_t offsetPos = content.find("offset=\"", element) + 8;
+        std::size_t offset = std::stoul(content.substr(offsetPos));
+        std::size_t start = content.find("_", content.find("<AppendedData")) +
+                            1 + offset;
+
+        // reads count bytes starting at the given position of the data
+        auto read = [&](std::size_t& pos, std::size_t count) {
+            std::vector<unsigned char> bytes;
+            if (base64) {
+                std::size_t chars = (count + 2) / 3 * 4;
+                bytes = decodeBase64(content.substr(pos, chars));
+                bytes.resize(count);
+                pos += chars;
+            } else {
+                bytes.assign(content.begin() + pos,
+                             content.begin() + pos + count);
+                pos += count;
+            }
+            return bytes;
+        };
+
+        std::size_t pos = start;
+        if (!compressed) {
+            std::vector<unsigned char> header = read(pos, 8);
+            std::uint64_t bytes;
+            std::memcpy(&bytes, header.data(), 8);
+            return read(pos, bytes);
+        }
+
+        // the first three words determine the size of the header
+        std::size_t peek = pos;
+        std::vector<unsigned char> first = read(peek, 24);
+        std::uint64_t blocks;
+        std::memcpy(&blocks, first.data(), 8);
+        std::vector<unsigned char> headerBytes = read(pos, (3 + blocks) * 8);
+        std::vector<std::uint64_t> header(3 + blocks);
+        std::memcpy(header.data(), headerBytes.data(), headerBytes.size());
+
+        std::size_t total = 0;
+        for (std::size_t b = 0; b < blocks; b++) {
+            total += header[3 + b];
+        }
+        std::vector<unsigned char> data = read(pos, total);
+
+        std::vector<unsigned char> result;
+#ifndef NO_ZLIB
+        std::size_t consumed = 0;
+        for (std::size_t b = 0; b < blocks; b++) {
+            uLongf size = header[1];
+            if (b + 1 == blocks && header[2] != 0) {
+                size = header[2];
+            }
+            std::size_t resultStart = result.size();
+            result.resize(resultStart + size);
+            uncompress(result.data() + resultStart, &size,
+                       data.data() + consumed, header[3 + b]);
+            consumed += header[3 + b];
+        }
+#endif
+        return result;
+    }
+
+    /**
+     * Checks the positions, masses and types in the file
+     */
+    void expectParticles(const std::string& content, bool base64,
+                         bool compressed) {
+        std::vector<unsigned char> points =
+            readArray(content, "points", base64, compressed);
+        std::vector<unsigned char> masses =
+            readArray(content, "mass", base64, compressed);
+        std::vector<unsigned char> types =
+            readArray(content, "type", base64, compressed);
+        ASSERT_EQ(3 * init.size() * sizeof(float), points.size());
+        ASSERT_EQ(init.size() * sizeof(float), masses.size());
+        ASSERT_EQ(init.size() * sizeof(std::int32_t), types.size());
+
+        std::size_t i = 0;
+        for (auto& p : init) {
+            float value[3];
+            std::memcpy(value, points.data() + 3 * i * sizeof(float),
+                        sizeof(value));
+            for (int d = 0; d < 3; d++) {
+                ASSERT_EQ((float)p.getX()[d], value[d]);
+            }
+
+            float mass;
+            std::memcpy(&mass, masses.data() + i * sizeof(float), 4);
+            ASSERT_EQ((float)p.getM(), mass);
+
+            std::int32_t type;
+            std::memcpy(&type, types.data() + i * sizeof(std::int32_t), 4);
+            ASSERT_EQ(p.getType(), type);
+            i++;
+        }
+    }
+
+    std::list<Particle> init;
+};
+
+TEST_F(VTKBinaryWriterTest, raw) {
+    VTKBinaryWriter writer(VTKBinaryWriter::Encoding::raw);
+    std::string content = write(writer);
+
+    ASSERT_NE(std::string::npos, content.find("encoding=\"raw\""));
+    ASSERT_NE(std::string::npos, content.find("NumberOfPoints=\"50\""));
+    expectParticles(content, false, false);
+}
+
+TEST_F(VTKBinaryWriterTest, base64) {
+    VTKBinaryWriter writer(VTKBinaryWriter::Encoding::base64);
+    std::string content = write(writer);
+
+    ASSERT_NE(std::string::npos, content.find("encoding=\"base64\""));
+    expectParticles(content, true, false);
+}
+
+TEST_F(VTKBinaryWriterTest, compressed) {
+    if (!VTKBinaryWriter::compressionAvailable()) {
+        GTEST_SKIP() << "built without zlib";
+    }
+    for (auto encoding : {VTKBinaryWriter::Encoding::raw,
+                          VTKBinaryWriter::Encoding::base64}) {
+        VTKBinaryWriter writer(encoding, true);
+        std::string content = write(writer);
+
+        ASSERT_NE(std::string::npos, content.find("vtkZLibDataCompressor"));
+        expectParticles(content, encoding == VTKBinaryWriter::Encoding::base64,
+                        true);
+    }
+}
+
+TEST_F(VTKBinaryWriterTest, reportsUnwritableFile) {
+    VTKBinaryWriter writer;
+    ParticleContainer pc(init.size(), init);
+    std::string prefix = testing::TempDir() + "missing_directory/vtkbin_test";
+
+    ASSERT_THROW(writer.plotParticles(pc, prefix, 7), std::runtime_error);
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "container/Particle.h"
+#include "container/ParticleContainer.h"
+#include "force/CentralForce.h"
+#include "force/Force.h"
+#include "force/LennardJonesMolecule.h"
+#include "force/Planet.h"
+#include "simulation/StoermerVerlet.h"
+#include "utils/ArrayUtils.h"
+#include "utils/Simd.h"
+
+#ifndef TOLERANCE
+#define TOLERANCE 1e-7
+#endif
+
+/**
+ * A central force unknown at compile time (like a plugin), which has to be
+ * called through the virtual interface
+ */
+class PluginForce : public CentralForce {
+   private:
+    LennardJonesMolecule ljm;
+
+   public:
+    PluginForce() : ljm(1, 1) {}
+
+    double calculateScalar(double distanceSq, double m1,
+                           double m2) const override {
+        return ljm.calculateScalar(distanceSq, m1, m2);
+    }
+
+    std::string typeString() override { return "Plugin"; }
+};
+
+/**
+ * A plugin which only implements the Force interface: a drag between close
+ * particles, which depends on their velocities and is no central force
+ */
+class DragForce : public Force {
+   public:
+    std::array<double, 3> calculateForce(Particle& p1,
+                                         Particle& p2) const override {
+        return -0.5 * (p1.getV() - p2.getV());
+    }
+
+    std::string typeString() override { return "Drag"; }
+};
+
+class ForceFunctionTest : public testing::Test {
+   protected:
+    ForceFunctionTest() {
+        for (int x = 0; x < 4; x++) {
+            for (int y = 0; y < 3; y++) {
+                for (int z = 0; z < 3; z++) {
+                    std::array<double, 3> pos = {x * 1.1 + 0.1 * (y % 2),
+                                                 y * 1.2, z * 1.05};
+                    init.emplace_back(pos, v, 1. + 0.5 * x, 0);
+                }
+            }
+        }
+    }
+
+    /**
+     * Compares the forces of both containers
+     */
+    void expectSameForces(ParticleContainer& a, ParticleContainer& b) {
+        for (std::size_t i = 0; i < a.size(); i++) {
+            for (int d = 0; d < 3; d++) {
+                ASSERT_NEAR(a.force(d)[i], b.force(d)[i], tolerance);
+            }
+        }
+    }
+
+    std::array<double, 3> v = {0, 0, 0};
+    std::list<Particle> init;
+    double tolerance = TOLERANCE;
+};
+
+TEST_F(ForceFunctionTest, virtualAndInlinedAgree) {
+    ParticleContainer inlined(init.size(), init, 2.);
+    ParticleContainer virtualCalls(init.size(), init, 2.);
+
+    LennardJonesMolecule ljm(1, 1);
+    PluginForce plugin;
+
+    calculateF(inlined, ljm);
+    calculateF(virtualCalls, static_cast<const CentralForce&>(plugin));
+
+    expectSameForces(inlined, virtualCalls);
+}
+
+TEST_F(ForceFunctionTest, matchesParticleInterface) {
+    ParticleContainer pc(init.size(), init);
+    Planet planet;
+
+    calculateF(pc, std::shared_ptr<Force>(new Planet()));
+
+    // the force on a particle is the sum over all pair forces
+    std::vector<Particle> particles(init.begin(), init.end());
+    for (std::size_t i = 0; i < particles.size(); i++) {
+        std::array<double, 3> expected = {0, 0, 0};
+        for (std::size_t j = 0; j < particles.size(); j++) {
+            if (i != j) {
+                expected = expected +
+                           planet.calculateForce(particles[i], particles[j]);
+            }
+        }
+        for (int d = 0; d < 3; d++) {
+            ASSERT_NEAR(expected[d], pc.force(d)[i], tolerance);
+        }
+    }
+}
+
+TEST_F(ForceFunctionTest, callsPlainForcePlugins) {
+    std::list<Particle> moving;
+    for (const Particle& p : init) {
+        const std::array<double, 3>& x = p.getX();
+        moving.emplace_back(x, std::array<double, 3>{x[1], -x[0], x[2] * x[0]},
+                            p.getM(), 0);
+    }
+    ParticleContainer pc(moving.size(), moving, 1.5);
+    DragForce drag;
+    selectForceFunction(drag)(pc, drag);
+
+    // the force on a particle is the sum over the pairs within the cutoff
+    std::vector<Particle> particles(moving.begin(), moving.end());
+    for (std::size_t i = 0; i < particles.size(); i++) {
+        std::array<double, 3> expected = {0, 0, 0};
+        for (std::size_t j = 0; j < particles.size(); j++) {
+            if (i != j && ArrayUtils::L2Norm(particles[i].getX() -
+                                             particles[j].getX()) <= 1.5) {
+                expected = expected +
+                           drag.calculateForce(particles[i], particles[j]);
+            }
+        }
+        for (int d = 0; d < 3; d++) {
+            ASSERT_NEAR(expected[d], pc.force(d)[i], tolerance);
+        }
+    }
+}
+
+TEST_F(ForceFunctionTest, selectsSpecializedFunction) {
+    LennardJonesMolecule ljm(1, 1);
+    Planet planet;
+    PluginForce plugin;
+
+    ForceFunction forLjm = selectForceFunction(ljm);
+    ForceFunction forPlanet = selectForceFunction(planet);
+    ForceFunction forPlugin = selectForceFunction(plugin);
+    DragForce drag;
+
+    ASSERT_NE(forLjm, forPlanet);
+    ASSERT_NE(forLjm, forPlugin);
+    ASSERT_NE(forPlanet, forPlugin);
+    ASSERT_NE(forPlugin, selectForceFunction(drag));
+
+    // planets with an opening angle use the Barnes-Hut approximation
+    Planet barnesHut(0.5);
+    ASSERT_NE(forPlanet, selectForceFunction(barnesHut));
+}
+
+TEST_F(ForceFunctionTest, simdLevelsAgree) {
+    LennardJonesMolecule ljm(1, 1);
+
+    ParticleContainer scalar(init.size(), init, 2.);
+    selectForceFunction(ljm, SimdLevel::scalar)(scalar, ljm);
+
+    for (SimdLevel level : {SimdLevel::avx2, SimdLevel::avx512}) {
+        if (!simd::isSupported(level)) {
+            continue;
+        }
+        ParticleContainer vectorized(init.size(), init, 2.);
+        selectForceFunction(ljm, level)(vectorized, ljm);
+        expectSameForces(scalar, vectorized);
+    }
+}
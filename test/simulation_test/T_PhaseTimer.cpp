@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "simulation/PhaseTimer.h"
+
+TEST(PhaseTimer, accumulatesPhases) {
+    PhaseTimer timer;
+    timer.reset();
+    for (int i = 0; i < 2; i++) {
+        PhaseTimer::Scope scope(timer, PhaseTimer::force);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    {
+        PhaseTimer::Scope scope(timer, PhaseTimer::output);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    ASSERT_GE(timer.seconds(PhaseTimer::force), 0.02);
+    ASSERT_GE(timer.seconds(PhaseTimer::output), 0.005);
+    ASSERT_EQ(0, timer.seconds(PhaseTimer::position));
+    ASSERT_EQ(0, timer.seconds(PhaseTimer::velocity));
+    ASSERT_GE(timer.totalSeconds(), timer.seconds(PhaseTimer::force) +
+                                        timer.seconds(PhaseTimer::output));
+
+    timer.reset();
+    ASSERT_EQ(0, timer.seconds(PhaseTimer::force));
+}
+
+TEST(PhaseTimer, summary) {
+    PhaseTimer timer;
+    {
+        PhaseTimer::Scope scope(timer, PhaseTimer::velocity);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::string summary = timer.summary(10, 1000);
+
+    ASSERT_NE(std::string::npos, summary.find("10 iterations"));
+    ASSERT_NE(std::string::npos, summary.find("MUPS"));
+    ASSERT_NE(std::string::npos, summary.find("velocity update"));
+    ASSERT_NE(std::string::npos, summary.find("other"));
+}
@@ -1,11 +1,21 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <limits>
 #include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "container/Particle.h"
 #include "container/ParticleContainer.h"
+#include "input/CuboidGenerator.h"
+#include "outputWriter/Writer.h"
+#include "simulation/Simulation.h"
 #include "simulation/StoermerVerlet.h"
 #include "force/LennardJonesMolecule.h"
+#include "force/Planet.h"
 
 #ifndef TOLERANCE
 #define TOLERANCE 1e-7;
@@ -47,7 +57,7 @@ TEST_F(StoermerVerletTest, testCalcX) {
     std::array<double, 3> force = {0, 0, 0.5};
     std::array<double, 3> velocity = {0, 1, 0};
 
-    for (Particle& p : StoermerVerletTest::pc) {
+    for (auto p : StoermerVerletTest::pc) {
         p.addF(force);
         p.addV(velocity);
     }
@@ -68,7 +78,7 @@ TEST_F(StoermerVerletTest, testCalcV) {
     std::array<double, 3> force = {0, 0, 0.5};
     std::array<double, 3> velocity = {0, 1, 0};
 
-    for (Particle& p : StoermerVerletTest::pc) {
+    for (auto p : StoermerVerletTest::pc) {
         p.addF(force);
         p.addV(velocity);
     }
@@ -91,7 +101,7 @@ TEST_F(StoermerVerletTest, testCalcF) {
 
     std::shared_ptr<Force> method = std::shared_ptr<Force>(new LennardJonesMolecule(1,1));
 
-    for (Particle& p : StoermerVerletTest::pc) {
+    for (auto p : StoermerVerletTest::pc) {
         p.addF(force);
         p.addV(velocity);
     }
@@ -105,4 +115,317 @@ TEST_F(StoermerVerletTest, testCalcF) {
             ASSERT_NEAR((double)i, (*(pc.begin() + j)).getV()[2], tolerance);
         }
     }
-}
\ No newline at end of file
+}
+
+namespace {
+/**
+ * Returns a warm cuboid whose particles interact with each other
+ */
+ParticleContainer warmCuboid() {
+    CuboidGenerator cuboid(5, 4, 3, 1.1225, 1, 1, {0, 0, 0}, {0, 0, 0}, 5);
+    ParticleContainer container(cuboid.count(), 2.5, 0.3);
+    cuboid.readInto(container, 0);
+    return container;
+}
+
+/**
+ * Records the positions and velocities of every output
+ */
+class RecordingWriter : public Writer {
+   public:
+    void plotParticles(ParticleContainer& container, const std::string&,
+                       int iteration) override {
+        iterations.push_back(iteration);
+        std::vector<double> state;
+        for (std::size_t i = 0; i < container.size(); i++) {
+            for (int d = 0; d < 3; d++) {
+                state.push_back(container.position(d)[i]);
+                state.push_back(container.velocity(d)[i]);
+            }
+        }
+        states.push_back(state);
+    }
+
+    std::string typeString() override { return "Recording"; }
+
+    std::vector<int> iterations;
+    std::vector<std::vector<double>> states;
+};
+
+/**
+ * Records the state at the end of the run. It is written as the final
+ * checkpoint, so it is available even if the output is compiled out
+ * (NO_OUT_FILE).
+ */
+std::shared_ptr<RecordingWriter> recordFinalState(Simulation& sim) {
+    auto writer = std::make_shared<RecordingWriter>();
+    sim.setCheckpoint(writer, std::numeric_limits<int>::max());
+    return writer;
+}
+
+/**
+ * Checks that both runs ended in the same state
+ */
+void expectSameFinalState(const RecordingWriter& expected,
+                          const RecordingWriter& actual, double tolerance) {
+    ASSERT_EQ(1, expected.states.size());
+    ASSERT_EQ(1, actual.states.size());
+    ASSERT_EQ(expected.iterations, actual.iterations);
+    for (std::size_t i = 0; i < expected.states[0].size(); i++) {
+        ASSERT_NEAR(expected.states[0][i], actual.states[0][i], tolerance);
+    }
+}
+
+/**
+ * Returns three planets orbiting the first one
+ */
+ParticleContainer planets() {
+    std::list<Particle> init;
+    init.emplace_back(std::array<double, 3>{0, 0, 0},
+                      std::array<double, 3>{0, 0, 0}, 1);
+    init.emplace_back(std::array<double, 3>{0, 1, 0},
+                      std::array<double, 3>{-1, 0, 0}, 3e-6);
+    init.emplace_back(std::array<double, 3>{0, 5.36, 0},
+                      std::array<double, 3>{-0.425, 0, 0}, 9.55e-4);
+    return ParticleContainer(init.size(), init);
+}
+
+/**
+ * Returns a light planet at the aphelion of an orbit with eccentricity 0.9
+ * and semi-major axis 1 around a sun, so the period is 2 pi and the
+ * perihelion at a distance of 0.1
+ */
+ParticleContainer eccentricOrbit() {
+    std::list<Particle> init;
+    init.emplace_back(std::array<double, 3>{0, 0, 0},
+                      std::array<double, 3>{0, 0, 0}, 1);
+    init.emplace_back(std::array<double, 3>{1.9, 0, 0},
+                      std::array<double, 3>{0, std::sqrt(0.1 / 1.9), 0},
+                      1e-9);
+    return ParticleContainer(init.size(), init);
+}
+}  // namespace
+
+TEST(FusedStoermerVerlet, matchesSeparateUpdates) {
+    const double dt = 0.0005;
+    LennardJonesMolecule method(5, 1);
+    ParticleContainer separate = warmCuboid();
+    ParticleContainer fused = warmCuboid();
+
+    for (int step = 0; step < 200; step++) {
+        calculateX(separate, dt, dt * dt);
+        calculateF(separate, method);
+        calculateV(separate, dt);
+
+        calculateKickDrift(fused, step == 0 ? dt / 2 : dt, dt);
+        calculateF(fused, method);
+    }
+    calculateKick(fused, dt / 2);
+
+    ASSERT_EQ(separate.getRebuildCount(), fused.getRebuildCount());
+    for (std::size_t i = 0; i < separate.size(); i++) {
+        for (int d = 0; d < 3; d++) {
+            ASSERT_NEAR(separate.position(d)[i], fused.position(d)[i], 1e-10);
+            ASSERT_NEAR(separate.velocity(d)[i], fused.velocity(d)[i], 1e-9);
+            ASSERT_NEAR(separate.force(d)[i], fused.force(d)[i], 1e-7);
+            ASSERT_NEAR(separate.oldForce(d)[i], fused.oldForce(d)[i], 1e-7);
+        }
+    }
+}
+
+TEST(FusedStoermerVerlet, simulationWritesFinishedSteps) {
+    const double dt = 0.0005;
+    auto method = std::make_shared<LennardJonesMolecule>(5, 1);
+    auto separate = std::make_shared<RecordingWriter>();
+    auto fused = std::make_shared<RecordingWriter>();
+
+    Simulation reference(warmCuboid(), method, separate, dt, 7, "separate");
+    auto separateEnd = recordFinalState(reference);
+    reference.run(0, 60 * dt);
+    Simulation sim(warmCuboid(), method, fused, dt, 7, "fused");
+    auto fusedEnd = recordFinalState(sim);
+    sim.setFused(true);
+    sim.run(0, 60 * dt);
+
+    expectSameFinalState(*separateEnd, *fusedEnd, 1e-10);
+#ifndef NO_OUT_FILE
+    ASSERT_EQ(9, fused->states.size());
+#endif
+    ASSERT_EQ(separate->iterations, fused->iterations);
+    for (std::size_t k = 0; k < separate->states.size(); k++) {
+        for (std::size_t i = 0; i < separate->states[k].size(); i++) {
+            ASSERT_NEAR(separate->states[k][i], fused->states[k][i], 1e-10);
+        }
+    }
+}
+
+TEST(Respa, sumsForcesOfAnIteration) {
+    const double dt = 0.0005;
+    auto whole = std::make_shared<RecordingWriter>();
+    auto split = std::make_shared<RecordingWriter>();
+
+    // epsilon is linear in the force, so 2 + 3 is the same as 5 + 0
+    Simulation reference(warmCuboid(),
+                         std::make_shared<LennardJonesMolecule>(5, 1), whole,
+                         dt, 9, "whole");
+    reference.addForce(std::make_shared<LennardJonesMolecule>(0, 1), 1);
+    auto wholeEnd = recordFinalState(reference);
+    reference.run(0, 40 * dt);
+    Simulation sim(warmCuboid(), std::make_shared<LennardJonesMolecule>(2, 1),
+                   split, dt, 9, "split");
+    sim.addForce(std::make_shared<LennardJonesMolecule>(3, 1), 1);
+    auto splitEnd = recordFinalState(sim);
+    sim.run(0, 40 * dt);
+
+    expectSameFinalState(*wholeEnd, *splitEnd, 1e-10);
+#ifndef NO_OUT_FILE
+    ASSERT_EQ(5, split->states.size());
+#endif
+    ASSERT_EQ(whole->iterations, split->iterations);
+    for (std::size_t k = 0; k < whole->states.size(); k++) {
+        for (std::size_t i = 0; i < whole->states[k].size(); i++) {
+            ASSERT_NEAR(whole->states[k][i], split->states[k][i], 1e-10);
+        }
+    }
+}
+
+TEST(Respa, slowForceKicksWithItsInterval) {
+    // without fast forces, gravity every 4 iterations of dt is velocity
+    // Verlet with 4 dt
+    const double dt = 0.001;
+    auto fine = std::make_shared<RecordingWriter>();
+    auto coarse = std::make_shared<RecordingWriter>();
+    auto none = std::make_shared<LennardJonesMolecule>(0, 1);
+
+    Simulation respa(planets(), none, fine, dt, 4, "fine");
+    respa.addForce(std::make_shared<Planet>(), 4);
+    auto fineEnd = recordFinalState(respa);
+    respa.run(3 * dt, 399 * dt);
+    Simulation verlet(planets(), none, coarse, 4 * dt, 1, "coarse");
+    verlet.addForce(std::make_shared<Planet>(), 1);
+    auto coarseEnd = recordFinalState(verlet);
+    verlet.run(0, 99 * 4 * dt);
+
+    // the last iterations of both runs end at the same time
+    ASSERT_EQ(1, fineEnd->states.size());
+    ASSERT_EQ(1, coarseEnd->states.size());
+    ASSERT_EQ(399, fineEnd->iterations[0]);
+    ASSERT_EQ(99, coarseEnd->iterations[0]);
+    for (std::size_t i = 0; i < fineEnd->states[0].size(); i++) {
+        ASSERT_NEAR(fineEnd->states[0][i], coarseEnd->states[0][i], 1e-10);
+    }
+
+#ifndef NO_OUT_FILE
+    ASSERT_EQ(100, fine->states.size());
+    ASSERT_EQ(fine->states.size(), coarse->states.size());
+    for (std::size_t k = 0; k < fine->states.size(); k++) {
+        ASSERT_EQ(4 * (int)k + 3, fine->iterations[k]);
+        for (std::size_t i = 0; i < fine->states[k].size(); i++) {
+            ASSERT_NEAR(fine->states[k][i], coarse->states[k][i], 1e-10);
+        }
+    }
+#endif
+}
+
+TEST(AdaptiveStoermerVerlet, timeStepLimitsDisplacement) {
+    std::list<Particle> init;
+    init.emplace_back(std::array<double, 3>{0, 0, 0},
+                      std::array<double, 3>{0, 0, 0}, 0.5);
+    init.emplace_back(std::array<double, 3>{5, 0, 0},
+                      std::array<double, 3>{0, 0, 0}, 1);
+    ParticleContainer container(init.size(), init);
+
+    ASSERT_TRUE(std::isinf(calculateTimeStep(container, 0.01)));
+
+    // |a| dt^2 / 2 = 0.01 with |a| = 4
+    container.force(2)[0] = 2;
+    ASSERT_DOUBLE_EQ(std::sqrt(0.005), calculateTimeStep(container, 0.01));
+
+    // |v| dt = 0.01 with |v| = 5 is shorter
+    container.velocity(0)[1] = 3;
+    container.velocity(1)[1] = 4;
+    ASSERT_DOUBLE_EQ(0.002, calculateTimeStep(container, 0.01));
+
+    // both together move the particle exactly the distance
+    container.velocity(0)[1] = 0;
+    container.velocity(1)[1] = 0;
+    container.velocity(0)[0] = 1;
+    const double dt = calculateTimeStep(container, 0.01);
+    ASSERT_DOUBLE_EQ(0.01, dt + 2 * dt * dt);
+}
+
+TEST(AdaptiveStoermerVerlet, largeDisplacementKeepsFixedStep) {
+    const double dt = 0.0005;
+    auto fixed = std::make_shared<RecordingWriter>();
+    auto adaptive = std::make_shared<RecordingWriter>();
+
+    Simulation reference(warmCuboid(),
+                         std::make_shared<LennardJonesMolecule>(5, 1), fixed,
+                         dt, 7, "fixed");
+    auto fixedEnd = recordFinalState(reference);
+    reference.run(0, 30 * dt);
+    Simulation sim(warmCuboid(), std::make_shared<LennardJonesMolecule>(5, 1),
+                   adaptive, dt, 7, "adaptive");
+    sim.setAdaptive(1e9, 1e-12);
+    auto adaptiveEnd = recordFinalState(sim);
+    sim.run(0, 30 * dt);
+
+    expectSameFinalState(*fixedEnd, *adaptiveEnd, 0);
+#ifndef NO_OUT_FILE
+    ASSERT_EQ(5, adaptive->states.size());
+#endif
+    ASSERT_EQ(fixed->iterations, adaptive->iterations);
+    for (std::size_t k = 0; k < fixed->states.size(); k++) {
+        for (std::size_t i = 0; i < fixed->states[k].size(); i++) {
+            ASSERT_DOUBLE_EQ(fixed->states[k][i], adaptive->states[k][i]);
+        }
+    }
+}
+
+TEST(AdaptiveStoermerVerlet, resolvesCloseEncounter) {
+    // one period in 200 iterations, which moves the planet almost as far as
+    // the perihelion distance in one step
+    const double dt = 2 * M_PI / 200;
+    auto error = [](const RecordingWriter& writer) {
+        const std::vector<double>& last = writer.states.at(0);
+        // the planet relative to the sun, back at the aphelion
+        return std::hypot(last[6] - last[0] - 1.9, last[8] - last[2]);
+    };
+
+    auto fixed = std::make_shared<RecordingWriter>();
+    Simulation reference(eccentricOrbit(), std::make_shared<Planet>(), fixed,
+                         dt, 50, "fixed");
+    auto fixedEnd = recordFinalState(reference);
+    reference.run(49.5 * dt, 199.5 * dt);
+    auto adaptive = std::make_shared<RecordingWriter>();
+    Simulation sim(eccentricOrbit(), std::make_shared<Planet>(), adaptive, dt,
+                   50, "adaptive");
+    sim.setAdaptive(0.002, 1e-9);
+    auto adaptiveEnd = recordFinalState(sim);
+    sim.run(49.5 * dt, 199.5 * dt);
+
+    ASSERT_EQ((std::vector<int>{199}), adaptiveEnd->iterations);
+    ASSERT_LT(error(*adaptiveEnd), 0.01);
+    ASSERT_LT(error(*adaptiveEnd), error(*fixedEnd) / 10);
+
+#ifndef NO_OUT_FILE
+    // the output stays on the grid of the fixed step
+    ASSERT_EQ((std::vector<int>{99, 149, 199}), adaptive->iterations);
+    ASSERT_EQ(fixed->iterations, adaptive->iterations);
+    ASSERT_EQ(adaptiveEnd->states[0], adaptive->states.back());
+#endif
+}
+
+TEST(AdaptiveStoermerVerlet, rejectsSeveralForces) {
+    auto writer = std::make_shared<RecordingWriter>();
+    auto none = std::make_shared<LennardJonesMolecule>(0, 1);
+
+    Simulation respa(planets(), none, writer, 0.001, 1, "respa");
+    respa.addForce(std::make_shared<Planet>(), 4);
+    ASSERT_THROW(respa.setAdaptive(0.01, 1e-9), std::invalid_argument);
+
+    Simulation adaptive(planets(), none, writer, 0.001, 1, "adaptive");
+    adaptive.setAdaptive(0.01, 1e-9);
+    ASSERT_THROW(adaptive.addForce(std::make_shared<Planet>(), 4),
+                 std::invalid_argument);
+}
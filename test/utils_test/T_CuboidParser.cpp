@@ -26,6 +26,20 @@ TEST(ParseCuboidsTest, HandlesValidInput) {
     ASSERT_EQ(cuboid.getMeanBrownianMotion(), 12.0);
 }
 
+TEST(ParseCuboidsTest, HandlesTypes) {
+    std::vector<CuboidGenerator> cuboids;
+    std::string input =
+        "[[0,0,0],[0,0,0],1,1,2,2,2,0.1,3],[[0,0,0],[5,0,0],1,1,2,2,2,0.1]";
+    parser::parseCuboids(input, cuboids);
+
+    ASSERT_EQ(cuboids.size(), 2);
+    ASSERT_EQ(cuboids[0].getMeanBrownianMotion(), 0.1);
+    ASSERT_EQ(cuboids[0].getType(), 3);
+    // the type is optional
+    ASSERT_EQ(cuboids[1].getType(), 0);
+    ASSERT_EQ(cuboids[1].getLLFC()[0], 5);
+}
+
 // TEST(ParseCuboidsTest, DeathTest_HandlesInvalidInput) {
 //     std::vector<CuboidGenerator> cuboids;
 //     std::string input = "[[1.0,2.0,3.0],[4.0,5.0,6.0],7.0,8.0,9,10,11]";
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "utils/Philox.h"
+
+// known answers of the reference implementation (Random123)
+TEST(PhiloxTest, knownAnswers) {
+    philox::Counter zero = philox::philox4x32({0, 0, 0, 0}, {0, 0});
+    ASSERT_EQ(0x6627e8d5u, zero[0]);
+    ASSERT_EQ(0xe169c58du, zero[1]);
+    ASSERT_EQ(0xbc57ac4cu, zero[2]);
+    ASSERT_EQ(0x9b00dbd8u, zero[3]);
+
+    philox::Counter pi = philox::philox4x32(
+        {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+        {0xa4093822, 0x299f31d0});
+    ASSERT_EQ(0xd16cfe09u, pi[0]);
+    ASSERT_EQ(0x94fdccebu, pi[1]);
+    ASSERT_EQ(0x5001e420u, pi[2]);
+    ASSERT_EQ(0x24126ea1u, pi[3]);
+}
+
+TEST(PhiloxTest, normalDistribution) {
+    const int n = 100000;
+    double sum = 0;
+    double sumSq = 0;
+    for (std::uint32_t i = 0; i < n; i++) {
+        std::array<double, 2> r = philox::normal2({i, 0, 0, 0}, {42, 0});
+        for (double v : r) {
+            ASSERT_TRUE(std::isfinite(v));
+            sum += v;
+            sumSq += v * v;
+        }
+    }
+    const double mean = sum / (2 * n);
+    ASSERT_NEAR(0, mean, 0.01);
+    ASSERT_NEAR(1, sumSq / (2 * n) - mean * mean, 0.01);
+}